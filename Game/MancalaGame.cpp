@@ -2,42 +2,83 @@
 #include "ThemeManager.h"
 #include <glm/gtc/constants.hpp>
 
+#include <algorithm>
+#include <filesystem>
 #include <iostream>
 
 MancalaGame::MancalaGame() 
     : m_currentPlayer(Player::PLAYER_ONE),
       m_gameState(GameState::PLAYING),
-      m_isAnimating(false),
-      m_animationProgress(0.0f),
-      m_board(nullptr) {
+      m_isAnimating(false) {
 }
 
-MancalaGame::~MancalaGame() {
-    // Cleanup all game objects
-    delete m_board;
-    for (auto& pit : m_pits) {
-        delete pit.pitObject;
-        for (auto* seed : pit.seeds) {
-            delete seed;
-        }
-    }
-}
+MancalaGame::~MancalaGame() = default;   // Game objects are owned by m_entities
 
 void MancalaGame::initialize() {
+    m_cubeMesh = std::shared_ptr<Mesh>(new Mesh(Mesh::createCube()));
+    // 16 segments up close, down to 4 for distant spectator views (thresholds in pixels)
+    m_seedLOD = MeshLOD::createSphere(SEED_RADIUS, { 16, 10, 6, 4 }, { 48.0f, 20.0f, 8.0f, 0.0f });
+
+    // Optional artist models (authored in world units), cubes otherwise
+    m_boardModel = loadCustomModel(BOARD_MODEL_PATH);
+    m_pitModel   = loadCustomModel(PIT_MODEL_PATH);
+    m_storeModel = loadCustomModel(STORE_MODEL_PATH);
+
+    // Board + 14 pits + seeds: no reallocation while the scene is built
+    m_entities.reserve(1 + 14 + 2 * PITS_PER_PLAYER * INITIAL_SEEDS_PER_PIT);
+
     createBoard();
     createPits();
     createSeeds();
     updateSeedPositions();
 }
 
+std::shared_ptr<Mesh> MancalaGame::loadCustomModel(const char* path) {
+    if (!std::filesystem::exists(path)) return nullptr;
+
+    try {
+        return std::shared_ptr<Mesh>(new Mesh(Mesh::loadFromOBJ(path)));
+    } catch (const std::exception& e) {
+        std::cerr << "[Game] Failed to load " << path << ": " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+void MancalaGame::setPitMesh(GameObject* pitObject, bool isStore, const glm::vec3& cubeScale) {
+    const std::shared_ptr<Mesh>& model = isStore ? m_storeModel : m_pitModel;
+    if (model) {
+        pitObject->setMesh(model);
+    } else {
+        pitObject->setMesh(m_cubeMesh);
+        pitObject->getTransform().setScale(cubeScale);
+    }
+}
+
+EntityHandle MancalaGame::createPitEntity(const Pit& pit, const glm::vec3& cubeScale) {
+    EntityHandle handle = m_entities.create();
+    GameObject* pitObject = m_entities.get(handle);
+    setPitMesh(pitObject, pit.isStore, cubeScale);
+    pitObject->getTransform().setPosition(pit.basePosition);
+
+    ThemeManager::getInstance().applyThemeToPit(pitObject, pit.index);
+
+    // Picking resolves a hit straight to the pit index
+    m_entities.setPickable(handle, pit.index);
+    return handle;
+}
+
 void MancalaGame::createBoard() {
-    m_board = new GameObject();
-    Mesh* boardMesh = new Mesh(Mesh::createCube());
-    m_board->setMesh(boardMesh);
-    m_board->getTransform().setScale(glm::vec3(10.0f, 0.3f, 4.0f));
-    m_board->getTransform().setPosition(glm::vec3(0.0f, -0.15f, 0.0f));
+    m_board = m_entities.create();
+    GameObject* board = m_entities.get(m_board);
+    if (m_boardModel) {
+        board->setMesh(m_boardModel);
+    } else {
+        board->setMesh(m_cubeMesh);
+        board->getTransform().setScale(glm::vec3(10.0f, 0.3f, 4.0f));
+    }
+    board->getTransform().setPosition(glm::vec3(0.0f, -0.15f, 0.0f));
     
-    ThemeManager::getInstance().applyThemeToBoard(m_board);
+    ThemeManager::getInstance().applyThemeToBoard(board);
 }
 
 void MancalaGame::createPits() {
@@ -55,14 +96,8 @@ void MancalaGame::createPits() {
         float z = -1.0f;
         pit.basePosition = glm::vec3(x, 0.0f, z);
         
-        // Create pit visual (cylinder for now, can be custom mesh)
-        pit.pitObject = new GameObject();
-        Mesh* pitMesh = new Mesh(Mesh::createCube());  // Use cylinder if available
-        pit.pitObject->setMesh(pitMesh);
-        pit.pitObject->getTransform().setPosition(pit.basePosition);
-        pit.pitObject->getTransform().setScale(glm::vec3(0.8f, 0.3f, 0.8f));
-        
-        ThemeManager::getInstance().applyThemeToPit(pit.pitObject, i);
+        // Create pit visual (cube or custom mesh)
+        pit.pitEntity = createPitEntity(pit, glm::vec3(0.8f, 0.3f, 0.8f));
     }
     
     // Player 1 store (6)
@@ -73,13 +108,7 @@ void MancalaGame::createPits() {
         pit.owner = Player::PLAYER_ONE;
         pit.basePosition = glm::vec3(-4.5f, 0.0f, 0.0f);
         
-        pit.pitObject = new GameObject();
-        Mesh* storeMesh = new Mesh(Mesh::createCube());
-        pit.pitObject->setMesh(storeMesh);
-        pit.pitObject->getTransform().setPosition(pit.basePosition);
-        pit.pitObject->getTransform().setScale(glm::vec3(1.0f, 0.5f, 1.5f));
-        
-        ThemeManager::getInstance().applyThemeToPit(pit.pitObject, 6);
+        pit.pitEntity = createPitEntity(pit, glm::vec3(1.0f, 0.5f, 1.5f));
     }
     
     // Player 2 pits (7-12) - Top row
@@ -95,13 +124,7 @@ void MancalaGame::createPits() {
         float z = 1.0f;
         pit.basePosition = glm::vec3(x, 0.0f, z);
         
-        pit.pitObject = new GameObject();
-        Mesh* pitMesh = new Mesh(Mesh::createCube());
-        pit.pitObject->setMesh(pitMesh);
-        pit.pitObject->getTransform().setPosition(pit.basePosition);
-        pit.pitObject->getTransform().setScale(glm::vec3(0.8f, 0.3f, 0.8f));
-        
-        ThemeManager::getInstance().applyThemeToPit(pit.pitObject, pitIdx);
+        pit.pitEntity = createPitEntity(pit, glm::vec3(0.8f, 0.3f, 0.8f));
     }
     
     // Player 2 store (13)
@@ -112,13 +135,7 @@ void MancalaGame::createPits() {
         pit.owner = Player::PLAYER_TWO;
         pit.basePosition = glm::vec3(4.5f, 0.0f, 0.0f);
         
-        pit.pitObject = new GameObject();
-        Mesh* storeMesh = new Mesh(Mesh::createCube());
-        pit.pitObject->setMesh(storeMesh);
-        pit.pitObject->getTransform().setPosition(pit.basePosition);
-        pit.pitObject->getTransform().setScale(glm::vec3(1.0f, 0.5f, 1.5f));
-        
-        ThemeManager::getInstance().applyThemeToPit(pit.pitObject, 13);
+        pit.pitEntity = createPitEntity(pit, glm::vec3(1.0f, 0.5f, 1.5f));
     }
 }
 
@@ -130,11 +147,11 @@ void MancalaGame::createSeeds() {
         if (m_pits[i].isStore) continue;  // Stores start empty
         
         for (int j = 0; j < INITIAL_SEEDS_PER_PIT; ++j) {
-            GameObject* seed = new GameObject();
-            Mesh* seedMesh = new Mesh(Mesh::createSphere(SEED_RADIUS, 16));
-            seed->setMesh(seedMesh);
+            EntityHandle seed = m_entities.create();
+            GameObject* seedObject = m_entities.get(seed);
+            seedObject->setLOD(m_seedLOD);
             
-            ThemeManager::getInstance().applyThemeToSeed(seed, seedIdx++);
+            ThemeManager::getInstance().applyThemeToSeed(seedObject, seedIdx++);
             
             m_pits[i].seeds.push_back(seed);
         }
@@ -166,7 +183,7 @@ void MancalaGame::stackSeedsInPit(int pitIndex) {
         pos.z += radius * sin(angle) * (1.0f - layer * 0.1f);
         pos.y = height + layer * SEED_RADIUS * 2.5f;
         
-        pit.seeds[i]->getTransform().setPosition(pos);
+        m_entities.get(pit.seeds[i])->getTransform().setPosition(pos);
     }
 }
 
@@ -191,13 +208,17 @@ bool MancalaGame::isValidMove(int pitIndex) const {
 void MancalaGame::executeMove(int pitIndex) {
     if (!isValidMove(pitIndex)) return;
     
-    // TODO: Implement seed distribution with animation
-    // For now, simplified version:
-    
+    // The move is resolved at once; seeds then fly from where they were
+    SeedLayout before = captureSeedLayout();
+    std::vector<float> sowDelays(m_entities.size(), -1.0f);
+
     Pit& sourcePit = m_pits[pitIndex];
     int seedsToDistribute = sourcePit.seeds.size();
-    std::vector<GameObject*> seedsToMove = sourcePit.seeds;
+    std::vector<EntityHandle> seedsToMove = sourcePit.seeds;
     sourcePit.seeds.clear();
+
+    // One seed after the other, squeezed together for very large pits
+    const float sowInterval = std::min(SOW_INTERVAL, MAX_SOW_SPREAD / std::max(seedsToDistribute, 1));
     
     int currentPit = pitIndex;
     int lastPit = -1;
@@ -213,6 +234,7 @@ void MancalaGame::executeMove(int pitIndex) {
         }
         
         m_pits[currentPit].seeds.push_back(seedsToMove[i]);
+        sowDelays[m_entities.indexOf(seedsToMove[i])] = i * sowInterval;
         lastPit = currentPit;
     }
     
@@ -236,6 +258,64 @@ void MancalaGame::executeMove(int pitIndex) {
     
     // Check win condition
     checkWinCondition();
+
+    // Captures start once the last sown seed has landed
+    animateSeedMoves(before, sowDelays, (seedsToDistribute - 1) * sowInterval + SEED_FLIGHT_TIME);
+}
+
+MancalaGame::SeedLayout MancalaGame::captureSeedLayout() const {
+    SeedLayout layout;
+    const auto& objects = m_entities.getObjects();
+    layout.positions.reserve(objects.size());
+    for (const auto& object : objects) {
+        layout.positions.push_back(object.getTransform().getPosition());
+    }
+
+    layout.pits.assign(objects.size(), -1);
+    for (const auto& pit : m_pits) {
+        for (EntityHandle seed : pit.seeds) {
+            layout.pits[m_entities.indexOf(seed)] = pit.index;
+        }
+    }
+    return layout;
+}
+
+void MancalaGame::animateSeedMoves(const SeedLayout& before, const std::vector<float>& sowDelays, float sowEnd) {
+    m_animator.clear();
+
+    // Seeds already in a pit shuffle when the last newcomer lands there
+    std::vector<float> pitSettle(m_pits.size(), 0.0f);
+    for (const auto& pit : m_pits) {
+        for (EntityHandle seed : pit.seeds) {
+            int index = m_entities.indexOf(seed);
+            if (sowDelays[index] >= 0.0f) {
+                pitSettle[pit.index] = std::max(pitSettle[pit.index], sowDelays[index] + SEED_FLIGHT_TIME);
+            } else if (before.pits[index] != pit.index) {
+                pitSettle[pit.index] = std::max(pitSettle[pit.index], sowEnd + SEED_FLIGHT_TIME);
+            }
+        }
+    }
+
+    for (const auto& pit : m_pits) {
+        for (EntityHandle seed : pit.seeds) {
+            int index = m_entities.indexOf(seed);
+            Transform& transform = m_entities.get(seed)->getTransform();
+            const glm::vec3& from = before.positions[index];
+            const glm::vec3 to = transform.getPosition();
+            if (from == to) continue;
+
+            if (sowDelays[index] >= 0.0f) {
+                m_animator.add(seed, from, to, sowDelays[index], SEED_FLIGHT_TIME, SEED_ARC_HEIGHT);   // sown
+            } else if (before.pits[index] != pit.index) {
+                m_animator.add(seed, from, to, sowEnd, SEED_FLIGHT_TIME, SEED_ARC_HEIGHT);            // captured
+            } else {
+                m_animator.add(seed, from, to, pitSettle[pit.index], RESTACK_TIME, 0.0f);              // restacked
+            }
+            transform.setPosition(from);
+        }
+    }
+
+    m_isAnimating = m_animator.isActive();
 }
 
 void MancalaGame::checkCapture(int lastPitIndex) {
@@ -313,10 +393,11 @@ void MancalaGame::switchPlayer() {
 }
 
 void MancalaGame::reset() {
-    // Clear all seeds
+    // Clear all seeds (board and pits keep their entities)
+    m_animator.clear();
     for (auto& pit : m_pits) {
-        for (auto* seed : pit.seeds) {
-            delete seed;
+        for (EntityHandle seed : pit.seeds) {
+            m_entities.destroy(seed);
         }
         pit.seeds.clear();
     }
@@ -331,22 +412,34 @@ void MancalaGame::reset() {
     m_isAnimating = false;
 }
 
-std::vector<GameObject*> MancalaGame::getAllObjects() const {
-    std::vector<GameObject*> objects;
-    
-    objects.push_back(m_board);
-    
+void MancalaGame::applyTheme() {
+    ThemeManager& themes = ThemeManager::getInstance();
+    themes.applyThemeToBoard(m_entities.get(m_board));
+
+    for (const auto& pit : m_pits) {
+        themes.applyThemeToPit(m_entities.get(pit.pitEntity), pit.index);
+    }
+
+    int seedIdx = 0;
     for (const auto& pit : m_pits) {
-        objects.push_back(pit.pitObject);
-        for (auto* seed : pit.seeds) {
-            objects.push_back(seed);
+        for (EntityHandle seed : pit.seeds) {
+            themes.applyThemeToSeed(m_entities.get(seed), seedIdx++);
         }
     }
+}
+
+std::vector<const GameObject*> MancalaGame::getAllObjects() const {
+    std::vector<const GameObject*> objects;
+    objects.reserve(m_entities.size());
+
+    for (const auto& object : m_entities.getObjects()) {
+        objects.push_back(&object);
+    }
     
     return objects;
 }
 
 void MancalaGame::updateAnimation(float deltaTime) {
-    // TODO: Implement smooth seed movement animation
-    m_isAnimating = false;
+    // Every seed of the move advances in one batched pass
+    m_isAnimating = m_animator.update(deltaTime, m_entities);
 }
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <vector>
+#include <memory>
 #include <glm/glm.hpp>
 #include "Scene/GameObject.h"
+#include "Scene/EntityStore.h"
+#include "SeedAnimator.h"
 
 /**
  * @brief Règles du Mancala:
@@ -29,8 +32,8 @@ public:
     };
 
     struct Pit {
-        GameObject* pitObject;           // Visual representation
-        std::vector<GameObject*> seeds;  // Seed objects in this pit
+        EntityHandle pitEntity;          // Visual representation
+        std::vector<EntityHandle> seeds; // Seed entities in this pit
         glm::vec3 basePosition;          // Pit center position
         int index;                       // 0-13 (0-5: P1, 6: Store1, 7-12: P2, 13: Store2)
         bool isStore;                    // Is this a store/mancala?
@@ -57,7 +60,13 @@ public:
     
     // Visual updates
     void updateSeedPositions();             // Arrange seeds visually in pits
-    std::vector<GameObject*> getAllObjects() const;
+    void applyTheme();                      // Re-apply current theme (board + pits + seeds)
+    std::vector<const GameObject*> getAllObjects() const;   // dense order of getEntities()
+    EntityHandle getBoard() const { return m_board; }
+
+    // Board, pits and seeds live in one dense store, referenced by handle
+    const EntityStore& getEntities() const { return m_entities; }
+    EntityStore& getEntities() { return m_entities; }
     
     // Getters
     const std::vector<Pit>& getPits() const { return m_pits; }
@@ -73,7 +82,6 @@ private:
     void createBoard();
     void createPits();
     void createSeeds();
-    void distributeSeedsAnimation(int startPitIndex);
     void checkCapture(int lastPitIndex);
     void checkWinCondition();
     void switchPlayer();
@@ -83,17 +91,39 @@ private:
     glm::vec3 calculateSeedPosition(int pitIndex, int seedIndexInPit);
     void stackSeedsInPit(int pitIndex);
 
+    // Where every seed was before a move (indexed like the entity store)
+    struct SeedLayout {
+        std::vector<glm::vec3> positions;
+        std::vector<int> pits;            // -1: not a seed
+    };
+    SeedLayout captureSeedLayout() const;
+
+    // Puts the moved seeds back where they were and flies them to their new spot
+    // (sowDelays: start time of each sown seed, -1 for the others)
+    void animateSeedMoves(const SeedLayout& before, const std::vector<float>& sowDelays, float sowEnd);
+
+    // Custom OBJ models: nullptr when the file is missing or invalid
+    static std::shared_ptr<Mesh> loadCustomModel(const char* path);
+    void setPitMesh(GameObject* pitObject, bool isStore, const glm::vec3& cubeScale);
+    EntityHandle createPitEntity(const Pit& pit, const glm::vec3& cubeScale);
+
     // Game data
     std::vector<Pit> m_pits;              // 14 pits total (6+1+6+1)
-    GameObject* m_board;                   // The wooden board
+    EntityStore m_entities;               // Owns every visual object
+    EntityHandle m_board;                 // The wooden board
+
+    // Shared GPU geometry (one VAO for all pits, one LOD chain for all seeds)
+    std::shared_ptr<Mesh> m_cubeMesh;
+    std::shared_ptr<MeshLOD> m_seedLOD;
+    std::shared_ptr<Mesh> m_boardModel;
+    std::shared_ptr<Mesh> m_pitModel;
+    std::shared_ptr<Mesh> m_storeModel;
     Player m_currentPlayer;
     GameState m_gameState;
     
     // Animation system
     bool m_isAnimating;
-    std::vector<GameObject*> m_animatingSeeds;
-    std::vector<glm::vec3> m_seedTargets;
-    float m_animationProgress;
+    SeedAnimator m_animator;
     
     // Configuration
     static constexpr int PITS_PER_PLAYER = 6;
@@ -101,6 +131,17 @@ private:
     static constexpr float PIT_SPACING = 1.2f;
     static constexpr float STORE_SPACING = 1.5f;
     static constexpr float SEED_RADIUS = 0.15f;
+
+    // Sowing animation (seconds, world units)
+    static constexpr float SOW_INTERVAL = 0.12f;       // between two sown seeds
+    static constexpr float MAX_SOW_SPREAD = 1.5f;      // large moves sow faster
+    static constexpr float SEED_FLIGHT_TIME = 0.45f;
+    static constexpr float SEED_ARC_HEIGHT = 0.8f;
+    static constexpr float RESTACK_TIME = 0.2f;        // seeds shuffling inside a pit
+
+    static constexpr const char* BOARD_MODEL_PATH = "Models/board.obj";
+    static constexpr const char* PIT_MODEL_PATH   = "Models/pit.obj";
+    static constexpr const char* STORE_MODEL_PATH = "Models/store.obj";
 };
 
 // Implementation details
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Game/MancalaGame.h"
+#include "Scene/EntityStore.h"
+#include "Scene/GameObject.h"
+
+/**
+ * @brief État du jeu figé par le thread de simulation pour le rendu
+ *
+ * - Copies des tableaux denses de l'EntityStore du jeu (GameObject, pickable,
+ *   poignées) : le rendu ne touche jamais aux objets du jeu
+ * - Données du HUD et de la sélection (scores, joueur, coups valides)
+ * - Ordre dense de l'EntityStore : stable d'un coup à l'autre (seul un reset
+ *   le modifie), les caches indexés du rendu restent valides
+ */
+struct RenderSnapshot {
+    struct PitView {
+        int objectIndex = -1;            // index dans objects
+        glm::vec3 basePosition{0.0f};
+        bool isStore = false;
+        bool validMove = false;          // isValidMove() au moment de la copie
+    };
+
+    std::vector<GameObject> objects;
+    std::vector<EntityHandle> handles;         // entité d'origine (identité entre copies)
+    std::vector<int> pickables;                // index de pit par objet, -1 pour plateau/graines
+    std::vector<PitView> pits;                 // 14, indexés comme MancalaGame::getPits()
+    int boardIndex = -1;
+
+    MancalaGame::Player currentPlayer = MancalaGame::Player::PLAYER_ONE;
+    MancalaGame::GameState gameState = MancalaGame::GameState::PLAYING;
+    int storeCounts[2] = { 0, 0 };
+    bool animating = false;
+    int themeIndex = 0;
+
+    uint64_t tick = 0;       // pas de simulation ayant produit la copie
+    float stepMs = 0.0f;     // durée de ce pas (commandes + animation + copie)
+    size_t transformBatch = 0;   // matrices recalculées par ce pas (TransformSystem)
+
+    bool isGameOver() const { return gameState != MancalaGame::GameState::PLAYING; }
+};
@@ -0,0 +1,99 @@
+#include "SeedAnimator.h"
+
+#include <algorithm>
+
+// 4 voies SSE2 (base x86-64), scalaire sinon
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MANCALA_SEED_SSE 1
+#endif
+
+void SeedAnimator::clear() {
+    m_seeds.clear();
+    for (auto* track : { &m_fromX, &m_fromY, &m_fromZ, &m_toX, &m_toY, &m_toZ,
+                         &m_start, &m_invDuration, &m_arc, &m_posX, &m_posY, &m_posZ }) {
+        track->clear();
+    }
+    m_landed.clear();
+    m_time = 0.0f;
+    m_endTime = 0.0f;
+}
+
+void SeedAnimator::add(EntityHandle seed, const glm::vec3& from, const glm::vec3& to,
+                       float delay, float duration, float arcHeight) {
+    duration = std::max(duration, 1e-3f);
+
+    m_seeds.push_back(seed);
+    m_fromX.push_back(from.x); m_fromY.push_back(from.y); m_fromZ.push_back(from.z);
+    m_toX.push_back(to.x);     m_toY.push_back(to.y);     m_toZ.push_back(to.z);
+    m_start.push_back(m_time + delay);
+    m_invDuration.push_back(1.0f / duration);
+    m_arc.push_back(arcHeight);
+    m_landed.push_back(0);
+
+    m_posX.push_back(from.x); m_posY.push_back(from.y); m_posZ.push_back(from.z);
+    m_endTime = std::max(m_endTime, m_time + delay + duration);
+}
+
+void SeedAnimator::evaluate() {
+    const size_t count = m_seeds.size();
+    size_t i = 0;
+
+#if defined(MANCALA_SEED_SSE)
+    // 4 pistes par itération ; sans -ffast-math le compilateur ne vectorise pas
+    // le bornage (min / max sur flottants), d'où les intrinsèques
+    const __m128 time = _mm_set1_ps(m_time);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 three = _mm_set1_ps(3.0f);
+    const __m128 four = _mm_set1_ps(4.0f);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 t = _mm_mul_ps(_mm_sub_ps(time, _mm_loadu_ps(&m_start[i])), _mm_loadu_ps(&m_invDuration[i]));
+        t = _mm_min_ps(_mm_max_ps(t, zero), one);
+        __m128 e = _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(three, _mm_mul_ps(two, t)));
+        __m128 lift = _mm_mul_ps(_mm_mul_ps(four, _mm_loadu_ps(&m_arc[i])), _mm_mul_ps(e, _mm_sub_ps(one, e)));
+
+        __m128 fromX = _mm_loadu_ps(&m_fromX[i]);
+        __m128 fromY = _mm_loadu_ps(&m_fromY[i]);
+        __m128 fromZ = _mm_loadu_ps(&m_fromZ[i]);
+        _mm_storeu_ps(&m_posX[i], _mm_add_ps(fromX, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_toX[i]), fromX), e)));
+        _mm_storeu_ps(&m_posY[i], _mm_add_ps(_mm_add_ps(fromY, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_toY[i]), fromY), e)), lift));
+        _mm_storeu_ps(&m_posZ[i], _mm_add_ps(fromZ, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_toZ[i]), fromZ), e)));
+    }
+#endif
+
+    // Même calcul en scalaire (reste du paquet, ou plateforme sans SSE2)
+    for (; i < count; ++i) {
+        float t = (m_time - m_start[i]) * m_invDuration[i];
+        t = std::min(std::max(t, 0.0f), 1.0f);
+        const float e = t * t * (3.0f - 2.0f * t);
+        const float lift = 4.0f * m_arc[i] * e * (1.0f - e);
+
+        m_posX[i] = m_fromX[i] + (m_toX[i] - m_fromX[i]) * e;
+        m_posY[i] = m_fromY[i] + (m_toY[i] - m_fromY[i]) * e + lift;
+        m_posZ[i] = m_fromZ[i] + (m_toZ[i] - m_fromZ[i]) * e;
+    }
+}
+
+bool SeedAnimator::update(float deltaTime, EntityStore& entities) {
+    m_time = std::min(m_time + deltaTime, m_endTime);
+    evaluate();
+
+    const bool finished = m_time >= m_endTime;
+    for (size_t i = 0; i < m_seeds.size(); ++i) {
+        // Pas encore partie (déjà à son départ) ou déjà posée : Transform intact
+        if (m_landed[i] || m_time <= m_start[i]) continue;
+
+        // Arrivée écrite exactement (pas d'écart d'arrondi sur la pile finale)
+        const bool landed = finished || (m_time - m_start[i]) * m_invDuration[i] >= 1.0f;
+        const glm::vec3 position = landed ? glm::vec3(m_toX[i], m_toY[i], m_toZ[i])
+                                          : glm::vec3(m_posX[i], m_posY[i], m_posZ[i]);
+        if (GameObject* seed = entities.get(m_seeds[i])) {
+            seed->getTransform().setPosition(position);
+        }
+        m_landed[i] = landed ? 1 : 0;
+    }
+    return isActive();
+}
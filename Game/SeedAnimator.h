@@ -0,0 +1,58 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include "Scene/EntityStore.h"
+
+/**
+ * @class SeedAnimator
+ * @brief Trajectoires des graines d'un coup, stockées en SoA et évaluées en lot
+ *
+ * - Une piste par graine : départ, arrivée, début (décalage), durée, hauteur d'arc
+ * - update() avance le temps puis évalue toutes les pistes dans une seule boucle
+ *   sans branche (bornage + smoothstep + parabole), 4 pistes à la fois en SSE2
+ * - Seules les graines en vol sont écrites dans leur Transform : une graine
+ *   posée ne change plus de version (pas de refit BVH / recalcul de matrice)
+ *
+ * Position : mix(départ, arrivée, e) + haut × 4 × arc × e × (1 − e),
+ * avec e = smoothstep du temps normalisé de la piste.
+ */
+class SeedAnimator {
+public:
+    void clear();
+
+    /**
+     * @param delay    secondes avant le départ (graines semées l'une après l'autre)
+     * @param arcHeight hauteur au sommet de la trajectoire (0 : glissement)
+     */
+    void add(EntityHandle seed, const glm::vec3& from, const glm::vec3& to,
+             float delay, float duration, float arcHeight);
+
+    /**
+     * @brief Avance de deltaTime et place les graines en vol
+     * @return true tant qu'une piste n'est pas terminée
+     */
+    bool update(float deltaTime, EntityStore& entities);
+
+    bool isActive() const { return m_time < m_endTime; }
+    size_t size() const { return m_seeds.size(); }
+
+private:
+    void evaluate();
+
+    // Pistes (SoA)
+    std::vector<EntityHandle> m_seeds;
+    std::vector<float> m_fromX, m_fromY, m_fromZ;
+    std::vector<float> m_toX, m_toY, m_toZ;
+    std::vector<float> m_start;          // temps de départ
+    std::vector<float> m_invDuration;
+    std::vector<float> m_arc;
+    std::vector<uint8_t> m_landed;       // position finale déjà écrite
+
+    // Résultat de evaluate()
+    std::vector<float> m_posX, m_posY, m_posZ;
+
+    float m_time = 0.0f;
+    float m_endTime = 0.0f;
+};
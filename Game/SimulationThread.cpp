@@ -0,0 +1,163 @@
+#include "SimulationThread.h"
+#include "MancalaGame.h"
+#include "ThemeManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using Clock = std::chrono::steady_clock;
+
+SimulationThread::SimulationThread(MancalaGame& game)
+    : m_game(game) {
+    publish(0.0f);
+}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start() {
+    if (m_thread.joinable()) return;
+    m_stopRequested = false;
+    m_thread = std::thread(&SimulationThread::run, this);
+    std::cout << "[Simulation] Thread started (" << TICK_RATE << " Hz while animating)\n";
+}
+
+void SimulationThread::stop() {
+    if (!m_thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+void SimulationThread::submit(const Command& command) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_commands.push_back(command);
+    }
+    m_wake.notify_one();
+}
+
+void SimulationThread::run() {
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / TICK_RATE));
+    Clock::time_point last = Clock::now();
+
+    while (true) {
+        bool idle = false;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            // Rien à simuler : dormir jusqu'à la prochaine commande
+            auto hasWork = [&] { return m_stopRequested || !m_commands.empty() || m_game.isAnimating(); };
+            if (!hasWork()) {
+                idle = true;
+                m_wake.wait(lock, hasWork);
+            }
+            if (m_stopRequested) break;
+        }
+
+        Clock::time_point now = Clock::now();
+        // Après une pause, le temps passé à dormir n'avance pas l'animation
+        float deltaTime = idle ? 0.0f
+                               : std::min(std::chrono::duration<float>(now - last).count(), MAX_STEP);
+        last = now;
+
+        step(deltaTime);
+
+        // Cadence fixe ; stop() interrompt l'attente
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait_until(lock, now + tickDuration, [&] { return m_stopRequested; });
+        if (m_stopRequested) break;
+    }
+}
+
+void SimulationThread::step(float deltaTime) {
+    Clock::time_point start = Clock::now();
+
+    bool changed = applyCommands();
+
+    if (m_game.isAnimating()) {
+        m_game.updateAnimation(deltaTime);
+        changed = true;
+    }
+
+    if (changed) {
+        publish(std::chrono::duration<float, std::milli>(Clock::now() - start).count());
+    }
+}
+
+bool SimulationThread::applyCommands() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_executing.swap(m_commands);
+    }
+
+    bool changed = false;
+    for (const Command& command : m_executing) {
+        switch (command.type) {
+            case CommandType::PLAY_MOVE:
+                // Revalidé ici : le rendu a décidé sur une copie qui peut dater d'un pas
+                if (m_game.isValidMove(command.value)) {
+                    m_game.executeMove(command.value);
+                    changed = true;
+                }
+                break;
+            case CommandType::RESET:
+                m_game.reset();
+                m_game.applyTheme();
+                changed = true;
+                break;
+            case CommandType::SET_THEME:
+                ThemeManager::getInstance().setTheme(command.value);
+                m_game.applyTheme();
+                changed = true;
+                break;
+        }
+    }
+    m_executing.clear();
+    return changed;
+}
+
+void SimulationThread::publish(float stepMs) {
+    RenderSnapshot& snapshot = m_snapshots.getWriteSlot();
+    EntityStore& entities = m_game.getEntities();
+
+    // Matrices des transforms modifiés depuis le pas précédent ; les autres objets
+    // gardent leur cache, la copie ci-dessous l'emporte tel quel
+    m_transforms.sync(entities.getObjects());
+    m_transforms.update();
+    m_transforms.apply(entities.getObjects());
+
+    // Tableaux denses : copies contiguës (capacité du slot réutilisée), sans parcours de pointeurs
+    snapshot.objects = entities.getObjects();
+    snapshot.handles = entities.getHandles();
+    snapshot.pickables = entities.getPickables();
+    snapshot.boardIndex = entities.indexOf(m_game.getBoard());
+
+    snapshot.pits.clear();
+    for (const auto& pit : m_game.getPits()) {
+        RenderSnapshot::PitView view;
+        view.objectIndex = entities.indexOf(pit.pitEntity);
+        view.basePosition = pit.basePosition;
+        view.isStore = pit.isStore;
+        view.validMove = m_game.isValidMove(pit.index);
+        snapshot.pits.push_back(view);
+    }
+
+    snapshot.currentPlayer = m_game.getCurrentPlayer();
+    snapshot.gameState = m_game.getGameState();
+    snapshot.storeCounts[0] = m_game.getStoreCount(MancalaGame::Player::PLAYER_ONE);
+    snapshot.storeCounts[1] = m_game.getStoreCount(MancalaGame::Player::PLAYER_TWO);
+    snapshot.animating = m_game.isAnimating();
+    snapshot.themeIndex = ThemeManager::getInstance().getCurrentThemeIndex();
+    snapshot.tick = ++m_tick;
+    snapshot.stepMs = stepMs;
+    snapshot.transformBatch = m_transforms.getLastUpdateCount();
+
+    m_snapshots.publish();
+
+    if (m_onPublish) m_onPublish();
+}
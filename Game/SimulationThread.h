@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Game/RenderSnapshot.h"
+#include "core/TripleBuffer.h"
+#include "Scene/TransformSystem.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class MancalaGame;
+
+/**
+ * @class SimulationThread
+ * @brief Mise à jour du jeu (coups, animation, thème) sur son propre thread
+ *
+ * - Le thread principal envoie des commandes (submit) au lieu de modifier le jeu
+ * - Chaque pas applique les commandes, avance l'animation puis publie un
+ *   RenderSnapshot dans un triple buffer : simulation et rendu ne s'attendent pas
+ * - Avant la copie, les matrices des objets modifiés sont recalculées en lot
+ *   (TransformSystem) : le snapshot arrive avec des caches à jour
+ * - Pas cadencés à TICK_RATE tant qu'une animation tourne ; sans commande
+ *   ni animation le thread dort
+ * - Sans start(), step() s'appelle directement (benchmark déterministe)
+ *
+ * Le jeu appartient au thread de simulation une fois start() appelé. Aucun
+ * appel OpenGL : meshes et textures (preloadTextures) doivent exister avant.
+ */
+class SimulationThread {
+public:
+    enum class CommandType {
+        PLAY_MOVE,   // value = index du pit
+        RESET,
+        SET_THEME    // value = index du thème
+    };
+
+    struct Command {
+        CommandType type;
+        int value = 0;
+    };
+
+    static constexpr double TICK_RATE = 120.0;   // pas par seconde pendant une animation
+    static constexpr float MAX_STEP = 0.1f;      // s, borne du pas après une pause
+
+    /**
+     * @brief Publie l'état initial (lisible avant start())
+     */
+    explicit SimulationThread(MancalaGame& game);
+    ~SimulationThread();
+
+    // Non-copiable (possède un thread)
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    void start();
+    void stop();
+    bool isRunning() const { return m_thread.joinable(); }
+
+    /**
+     * @brief Met une commande en file (appelable depuis n'importe quel thread)
+     */
+    void submit(const Command& command);
+
+    /**
+     * @brief Un pas : commandes en attente, animation, publication si l'état a changé
+     * Appelé par le thread de simulation, ou directement si le thread n'est pas démarré.
+     */
+    void step(float deltaTime);
+
+    /**
+     * @brief Appelé depuis le thread de simulation après chaque publication
+     * (ex : réveiller la boucle de rendu bloquée dans glfwWaitEvents)
+     */
+    void setPublishCallback(std::function<void()> callback) { m_onPublish = std::move(callback); }
+
+    // ===== CÔTÉ RENDU =====
+
+    bool hasNewSnapshot() const { return m_snapshots.hasFresh(); }
+
+    /**
+     * @brief Passe au dernier état publié
+     * @return false si rien de nouveau depuis le dernier appel
+     */
+    bool acquireSnapshot() { return m_snapshots.acquire(); }
+
+    /**
+     * @brief État courant du rendu, stable jusqu'au prochain acquireSnapshot()
+     */
+    RenderSnapshot& getSnapshot() { return m_snapshots.getReadSlot(); }
+    const RenderSnapshot& getSnapshot() const { return m_snapshots.getReadSlot(); }
+
+private:
+    void run();
+    bool applyCommands();
+    void publish(float stepMs);
+
+    MancalaGame& m_game;
+    TripleBuffer<RenderSnapshot> m_snapshots;
+    TransformSystem m_transforms;       // matrices des objets du jeu
+    uint64_t m_tick = 0;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::vector<Command> m_commands;    // protégé par m_mutex
+    std::vector<Command> m_executing;   // thread de simulation seulement
+    bool m_stopRequested = false;       // protégé par m_mutex
+
+    std::function<void()> m_onPublish;
+};
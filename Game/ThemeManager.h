@@ -1,9 +1,11 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <filesystem>
 #include <string>
 #include <vector>
 #include "Rendering/Material.h"
+#include "Rendering/TextureManager.h"
 
 /**
  * @brief Système de thèmes visuels pour personnalisation
@@ -53,12 +55,36 @@ public:
     void applyThemeToPit(GameObject* pit, int pitIndex);
     void applyThemeToSeed(GameObject* seed, int seedIndex);
 
+    /**
+     * @brief Lance le chargement asynchrone des textures de tous les thèmes
+     * (le changement de thème n'attend plus le décodage)
+     */
+    void preloadTextures();
+
+    // Côté des couches du tableau de textures d'un thème (pixels)
+    static constexpr int TEXTURE_LAYER_SIZE = 1024;
+
 private:
     ThemeManager() { loadThemes(); }
     
     void createDefaultThemes();
+
+    /**
+     * @brief Textures d'un thème regroupées dans un GL_TEXTURE_2D_ARRAY :
+     * une seule texture à binder pour tout le plateau, changer de thème
+     * revient à changer de tableau
+     */
+    struct ThemeTextures {
+        bool requested = false;
+        TextureHandle array = 0;
+        int boardLayer = -1;   // -1 : fichier absent
+        int seedLayer = -1;
+    };
+
+    const ThemeTextures& requestTextures(int themeIndex);
     
     std::vector<Theme> m_themes;
+    std::vector<ThemeTextures> m_themeTextures;
     int m_currentThemeIndex = 0;
 };
 
@@ -68,6 +94,7 @@ private:
 
 inline void ThemeManager::loadThemes() {
     m_themes.clear();
+    m_themeTextures.clear();
     createDefaultThemes();
 }
 
@@ -105,6 +132,9 @@ inline void ThemeManager::createDefaultThemes() {
         theme.backgroundColor = glm::vec3(0.1f, 0.1f, 0.12f);
         theme.fogColor = glm::vec3(0.2f, 0.2f, 0.25f);
         
+        // Optional texture (Textures/ relative to the working directory)
+        theme.boardTexture = "Textures/wood.png";
+        
         m_themes.push_back(theme);
     }
 
@@ -141,6 +171,9 @@ inline void ThemeManager::createDefaultThemes() {
         theme.backgroundColor = glm::vec3(0.05f, 0.05f, 0.08f);
         theme.fogColor = glm::vec3(0.1f, 0.1f, 0.15f);
         
+        // Optional texture (Textures/ relative to the working directory)
+        theme.boardTexture = "Textures/stone.png";
+        
         m_themes.push_back(theme);
     }
 
@@ -177,6 +210,9 @@ inline void ThemeManager::createDefaultThemes() {
         theme.backgroundColor = glm::vec3(0.15f, 0.12f, 0.08f);
         theme.fogColor = glm::vec3(0.3f, 0.25f, 0.15f);
         
+        // Optional texture (Textures/ relative to the working directory)
+        theme.boardTexture = "Textures/gold.png";
+        
         m_themes.push_back(theme);
     }
 
@@ -214,6 +250,9 @@ inline void ThemeManager::createDefaultThemes() {
         theme.backgroundColor = glm::vec3(0.0f, 0.0f, 0.05f);
         theme.fogColor = glm::vec3(0.05f, 0.05f, 0.15f);
         
+        // Optional texture (Textures/ relative to the working directory)
+        theme.boardTexture = "Textures/neon.png";
+        
         m_themes.push_back(theme);
     }
 }
@@ -233,9 +272,45 @@ inline void ThemeManager::setTheme(const std::string& name) {
     }
 }
 
+inline const ThemeManager::ThemeTextures& ThemeManager::requestTextures(int themeIndex) {
+    m_themeTextures.resize(m_themes.size());
+    ThemeTextures& textures = m_themeTextures[themeIndex];
+    if (textures.requested) return textures;
+    textures.requested = true;
+
+    const Theme& theme = m_themes[themeIndex];
+    std::vector<std::string> layers;
+    std::vector<glm::vec3> placeholders;
+
+    auto addLayer = [&](const std::string& path, glm::vec3 placeholder) {
+        if (path.empty() || !std::filesystem::exists(path)) return -1;
+        layers.push_back(path);
+        placeholders.push_back(placeholder);
+        return static_cast<int>(layers.size()) - 1;
+    };
+    textures.boardLayer = addLayer(theme.boardTexture, theme.boardMaterial.diffuse);
+    textures.seedLayer = addLayer(theme.seedTexture,
+                                  theme.seedColors.empty() ? glm::vec3(0.5f) : theme.seedColors[0]);
+
+    if (!layers.empty()) {
+        textures.array = TextureManager::getInstance().loadTextureArrayAsync(layers, TEXTURE_LAYER_SIZE,
+                                                                             true, placeholders);
+    }
+    return textures;
+}
+
+inline void ThemeManager::preloadTextures() {
+    for (size_t i = 0; i < m_themes.size(); ++i) {
+        requestTextures(static_cast<int>(i));
+    }
+}
+
 inline void ThemeManager::applyThemeToBoard(GameObject* board) {
     if (board) {
-        board->setMaterial(getCurrentTheme().boardMaterial);
+        const auto& theme = getCurrentTheme();
+        const ThemeTextures& textures = requestTextures(m_currentThemeIndex);
+        board->setMaterial(theme.boardMaterial);
+        board->setTexture(textures.array, textures.boardLayer);
     }
 }
 
@@ -259,5 +334,7 @@ inline void ThemeManager::applyThemeToSeed(GameObject* seed, int seedIndex) {
         mat.shininess = 64.0f;
         
         seed->setMaterial(mat);
+        const ThemeTextures& textures = requestTextures(m_currentThemeIndex);
+        seed->setTexture(textures.array, textures.seedLayer);
     }
 }
\ No newline at end of file
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+// 8 voies avec AVX (option CMake MANCALA_AVX2), 4 voies SSE2 (base x86-64), scalaire sinon
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MANCALA_AABB_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MANCALA_AABB_SSE 1
+#endif
+
+/**
+ * @class AABBPacket
+ * @brief Boîtes alignées sur les axes stockées en SoA, testées contre un rayon
+ * par paquets de 4 (SSE) ou 8 (AVX) boîtes
+ *
+ * - Une composante par tableau (minX, minY, ... maxZ) : chargements contigus
+ * - Test des dalles sans branche, inverse de la direction précalculé
+ * - Tableaux complétés de PADDING boîtes : un paquet peut déborder de la plage
+ *   demandée, les voies en trop sont ignorées
+ * - intersectScalar() : même calcul boîte par boîte (référence et benchmark)
+ *
+ * Distance rendue : entrée dans la boîte, ou sortie si l'origine est dedans
+ * (comme ObjectPicker::rayAABBIntersection) ; FLT_MAX si manquée.
+ */
+class AABBPacket {
+public:
+#if defined(MANCALA_AABB_AVX)
+    static constexpr int WIDTH = 8;
+#elif defined(MANCALA_AABB_SSE)
+    static constexpr int WIDTH = 4;
+#else
+    static constexpr int WIDTH = 1;
+#endif
+    static constexpr size_t PADDING = 8;
+
+    static const char* getKernelName() {
+#if defined(MANCALA_AABB_AVX)
+        return "AVX 8-wide";
+#elif defined(MANCALA_AABB_SSE)
+        return "SSE2 4-wide";
+#else
+        return "scalar";
+#endif
+    }
+
+    void clear() { resize(0); }
+
+    void resize(size_t count) {
+        m_count = count;
+        for (auto* component : { &m_minX, &m_minY, &m_minZ, &m_maxX, &m_maxY, &m_maxZ }) {
+            component->resize(count + PADDING, 0.0f);
+        }
+    }
+
+    void set(size_t index, const glm::vec3& boxMin, const glm::vec3& boxMax) {
+        m_minX[index] = boxMin.x; m_minY[index] = boxMin.y; m_minZ[index] = boxMin.z;
+        m_maxX[index] = boxMax.x; m_maxY[index] = boxMax.y; m_maxZ[index] = boxMax.z;
+    }
+
+    void add(const glm::vec3& boxMin, const glm::vec3& boxMax) {
+        resize(m_count + 1);
+        set(m_count - 1, boxMin, boxMax);
+    }
+
+    size_t size() const { return m_count; }
+
+    /**
+     * @brief Distances du rayon aux boîtes [first, first + count)
+     * @param invDirection 1 / direction (composante par composante)
+     * @param outDistances count valeurs ; FLT_MAX si manquée ou au-delà de maxDistance
+     */
+    void intersect(const glm::vec3& origin, const glm::vec3& invDirection,
+                   size_t first, size_t count, float maxDistance, float* outDistances) const;
+
+    void intersectScalar(const glm::vec3& origin, const glm::vec3& invDirection,
+                         size_t first, size_t count, float maxDistance, float* outDistances) const;
+
+private:
+    std::vector<float> m_minX, m_minY, m_minZ;
+    std::vector<float> m_maxX, m_maxY, m_maxZ;
+    size_t m_count = 0;
+};
+
+// ============================================
+// IMPLEMENTATION
+// ============================================
+
+inline void AABBPacket::intersectScalar(const glm::vec3& origin, const glm::vec3& invDirection,
+                                        size_t first, size_t count, float maxDistance,
+                                        float* outDistances) const {
+    for (size_t k = 0; k < count; ++k) {
+        size_t i = first + k;
+        float t0x = (m_minX[i] - origin.x) * invDirection.x, t1x = (m_maxX[i] - origin.x) * invDirection.x;
+        float t0y = (m_minY[i] - origin.y) * invDirection.y, t1y = (m_maxY[i] - origin.y) * invDirection.y;
+        float t0z = (m_minZ[i] - origin.z) * invDirection.z, t1z = (m_maxZ[i] - origin.z) * invDirection.z;
+
+        float enter = std::max(std::max(std::min(t0x, t1x), std::min(t0y, t1y)), std::min(t0z, t1z));
+        float exit  = std::min(std::min(std::max(t0x, t1x), std::max(t0y, t1y)), std::max(t0z, t1z));
+
+        float distance = (enter > 0.0f) ? enter : exit;
+        bool hit = std::max(enter, 0.0f) <= std::min(exit, maxDistance) && distance <= maxDistance;
+        outDistances[k] = hit ? distance : FLT_MAX;
+    }
+}
+
+#if defined(MANCALA_AABB_AVX)
+
+inline void AABBPacket::intersect(const glm::vec3& origin, const glm::vec3& invDirection,
+                                  size_t first, size_t count, float maxDistance, float* outDistances) const {
+    const __m256 ox = _mm256_set1_ps(origin.x), oy = _mm256_set1_ps(origin.y), oz = _mm256_set1_ps(origin.z);
+    const __m256 ix = _mm256_set1_ps(invDirection.x), iy = _mm256_set1_ps(invDirection.y),
+                 iz = _mm256_set1_ps(invDirection.z);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 limit = _mm256_set1_ps(maxDistance);
+    const __m256 miss = _mm256_set1_ps(FLT_MAX);
+    alignas(32) float lanes[8];
+
+    for (size_t k = 0; k < count; k += 8) {
+        size_t i = first + k;
+        __m256 t0x = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&m_minX[i]), ox), ix);
+        __m256 t1x = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&m_maxX[i]), ox), ix);
+        __m256 t0y = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&m_minY[i]), oy), iy);
+        __m256 t1y = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&m_maxY[i]), oy), iy);
+        __m256 t0z = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&m_minZ[i]), oz), iz);
+        __m256 t1z = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&m_maxZ[i]), oz), iz);
+
+        __m256 enter = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(t0x, t1x), _mm256_min_ps(t0y, t1y)),
+                                     _mm256_min_ps(t0z, t1z));
+        __m256 exit  = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(t0x, t1x), _mm256_max_ps(t0y, t1y)),
+                                     _mm256_max_ps(t0z, t1z));
+
+        __m256 distance = _mm256_blendv_ps(exit, enter, _mm256_cmp_ps(enter, zero, _CMP_GT_OQ));
+        __m256 hit = _mm256_and_ps(
+            _mm256_cmp_ps(_mm256_max_ps(enter, zero), _mm256_min_ps(exit, limit), _CMP_LE_OQ),
+            _mm256_cmp_ps(distance, limit, _CMP_LE_OQ));
+        _mm256_store_ps(lanes, _mm256_blendv_ps(miss, distance, hit));
+
+        std::copy(lanes, lanes + std::min<size_t>(8, count - k), outDistances + k);
+    }
+}
+
+#elif defined(MANCALA_AABB_SSE)
+
+inline void AABBPacket::intersect(const glm::vec3& origin, const glm::vec3& invDirection,
+                                  size_t first, size_t count, float maxDistance, float* outDistances) const {
+    const __m128 ox = _mm_set1_ps(origin.x), oy = _mm_set1_ps(origin.y), oz = _mm_set1_ps(origin.z);
+    const __m128 ix = _mm_set1_ps(invDirection.x), iy = _mm_set1_ps(invDirection.y),
+                 iz = _mm_set1_ps(invDirection.z);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 limit = _mm_set1_ps(maxDistance);
+    const __m128 miss = _mm_set1_ps(FLT_MAX);
+    alignas(16) float lanes[4];
+
+    for (size_t k = 0; k < count; k += 4) {
+        size_t i = first + k;
+        __m128 t0x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_minX[i]), ox), ix);
+        __m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_maxX[i]), ox), ix);
+        __m128 t0y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_minY[i]), oy), iy);
+        __m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_maxY[i]), oy), iy);
+        __m128 t0z = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_minZ[i]), oz), iz);
+        __m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&m_maxZ[i]), oz), iz);
+
+        __m128 enter = _mm_max_ps(_mm_max_ps(_mm_min_ps(t0x, t1x), _mm_min_ps(t0y, t1y)), _mm_min_ps(t0z, t1z));
+        __m128 exit  = _mm_min_ps(_mm_min_ps(_mm_max_ps(t0x, t1x), _mm_max_ps(t0y, t1y)), _mm_max_ps(t0z, t1z));
+
+        // SSE2 : pas de blendv, sélection par masques and / andnot / or
+        __m128 inFront = _mm_cmpgt_ps(enter, zero);
+        __m128 distance = _mm_or_ps(_mm_and_ps(inFront, enter), _mm_andnot_ps(inFront, exit));
+        __m128 hit = _mm_and_ps(_mm_cmple_ps(_mm_max_ps(enter, zero), _mm_min_ps(exit, limit)),
+                                _mm_cmple_ps(distance, limit));
+        _mm_store_ps(lanes, _mm_or_ps(_mm_and_ps(hit, distance), _mm_andnot_ps(hit, miss)));
+
+        std::copy(lanes, lanes + std::min<size_t>(4, count - k), outDistances + k);
+    }
+}
+
+#else
+
+inline void AABBPacket::intersect(const glm::vec3& origin, const glm::vec3& invDirection,
+                                  size_t first, size_t count, float maxDistance, float* outDistances) const {
+    intersectScalar(origin, invDirection, first, count, maxDistance, outDistances);
+}
+
+#endif
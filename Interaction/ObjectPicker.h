@@ -3,7 +3,10 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <initializer_list>
+#include "Interaction/AABBPacket.h"
 #include "Rendering/Camera.h"
 #include "Scene/GameObject.h"
 #include <vector>
@@ -76,10 +79,13 @@ public:
     );
 
     /**
-     * @brief Trouve l'objet le plus proche touché par le rayon
+     * @brief Trouve l'objet le plus proche touché par le rayon (test linéaire)
      * @param ray Rayon à tester
      * @param objects Liste d'objets à tester
      * @return Information sur le hit (ou hit=false si aucun)
+     * Objets avec mesh : boîte monde, testées par paquets (AABBPacket) ;
+     * sans mesh : sphère approchée depuis le scale
+     * Pour une scène entière, préférer SceneBVH::raycast (boîtes monde, arbre)
      */
     static RayHit pickObject(
         const Ray& ray,
@@ -123,14 +129,12 @@ inline ObjectPicker::Ray ObjectPicker::screenToWorldRay(
     // 2. NDC -> Clip coordinates (z=-1 pour near plane, w=1)
     glm::vec4 rayClip(x, y, -1.0f, 1.0f);
     
-    // 3. Clip -> Eye coordinates (inverse projection)
-    glm::mat4 projInverse = glm::inverse(camera.getProjectionMatrix());
-    glm::vec4 rayEye = projInverse * rayClip;
+    // 3. Clip -> Eye coordinates (inverse projection, mise en cache par la caméra)
+    glm::vec4 rayEye = camera.getInverseProjectionMatrix() * rayClip;
     rayEye = glm::vec4(rayEye.x, rayEye.y, -1.0f, 0.0f);  // Direction vers l'avant
     
     // 4. Eye -> World coordinates (inverse view)
-    glm::mat4 viewInverse = glm::inverse(camera.getViewMatrix());
-    glm::vec4 rayWorld4 = viewInverse * rayEye;
+    glm::vec4 rayWorld4 = camera.getInverseViewMatrix() * rayEye;
     glm::vec3 rayWorld = glm::normalize(glm::vec3(rayWorld4));
     
     Ray ray;
@@ -182,7 +186,7 @@ inline bool ObjectPicker::rayAABBIntersection(
     float tmax = FLT_MAX;
     
     for (int i = 0; i < 3; ++i) {
-        if (abs(ray.direction[i]) < 1e-6f) {
+        if (std::abs(ray.direction[i]) < 1e-6f) {
             // Rayon parallèle à la face
             if (ray.origin[i] < min[i] || ray.origin[i] > max[i]) {
                 return false;
@@ -213,8 +217,22 @@ inline ObjectPicker::RayHit ObjectPicker::pickObject(
     closestHit.distance = FLT_MAX;
     closestHit.object = nullptr;
     
+    // Boîtes monde en SoA, réutilisées d'un appel à l'autre
+    thread_local AABBPacket boxes;
+    thread_local std::vector<GameObject*> boxed;
+    thread_local std::vector<float> distances;
+    boxes.clear();
+    boxed.clear();
+
     for (GameObject* obj : objects) {
         if (!obj || !obj->isVisible()) continue;
+
+        glm::vec3 center, extent;
+        if (obj->getWorldBounds(center, extent)) {
+            boxes.add(center - extent, center + extent);
+            boxed.push_back(obj);
+            continue;
+        }
         
         glm::vec3 objPos = obj->getTransform().getPosition();
         glm::vec3 scale = obj->getTransform().getScale();
@@ -232,6 +250,17 @@ inline ObjectPicker::RayHit ObjectPicker::pickObject(
             }
         }
     }
+
+    distances.resize(boxed.size());
+    boxes.intersect(ray.origin, 1.0f / ray.direction, 0, boxed.size(), closestHit.distance, distances.data());
+    for (size_t i = 0; i < boxed.size(); ++i) {
+        if (distances[i] < closestHit.distance) {
+            closestHit.hit = true;
+            closestHit.distance = distances[i];
+            closestHit.object = boxed[i];
+            closestHit.hitPoint = ray.origin + ray.direction * distances[i];
+        }
+    }
     
     return closestHit;
 }
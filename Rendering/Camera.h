@@ -1,11 +1,12 @@
 #pragma once
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include "Frustum.h"
 
 class Camera {
 public:
     // Constructor with all parameters
-    Camera(const glm::vec3& position, const glm::vec3& target, 
+    Camera(const glm::vec3& position, const glm::vec3& target,
            float fov, float aspect, float near, float far)
         : m_position(position)
         , m_target(target)
@@ -23,18 +24,31 @@ public:
         : Camera(target + glm::vec3(0, 5, distance), target, 45.0f, 16.0f/9.0f, 0.1f, 100.0f)
     {}
 
+    // Setters only invalidate the cached matrices when the value actually changes
+    // (the orbit camera sets position and target every frame)
     void setPosition(const glm::vec3& position) {
+        if (position == m_position) return;
         m_position = position;
         updateVectors();
     }
 
     void lookAt(const glm::vec3& target) {
+        if (target == m_target) return;
         m_target = target;
         updateVectors();
     }
 
+    // Framebuffer resize: keeps the projection in step with the viewport
     void setAspect(float aspect) {
+        if (aspect == m_aspect || !(aspect > 0.0f)) return;
         m_aspect = aspect;
+        m_projectionDirty = true;
+    }
+
+    void setFov(float fov) {
+        if (fov == m_fov) return;
+        m_fov = fov;
+        m_projectionDirty = true;
     }
 
     glm::vec3 getPosition() const { return m_position; }
@@ -43,12 +57,53 @@ public:
     glm::vec3 getRight() const { return m_right; }
     glm::vec3 getUp() const { return m_up; }
 
-    glm::mat4 getViewMatrix() const {
-        return glm::lookAt(m_position, m_target, m_up);
+    float getFov() const { return m_fov; }
+    float getAspect() const { return m_aspect; }
+    float getNear() const { return m_near; }
+    float getFar() const { return m_far; }
+
+    // Cached matrices: rebuilt on first access after a change, shared by every
+    // consumer of the frame (uniforms, culling, LOD, picking, light clusters)
+    const glm::mat4& getViewMatrix() const {
+        updateMatrices();
+        return m_view;
+    }
+
+    const glm::mat4& getProjectionMatrix() const {
+        updateMatrices();
+        return m_projection;
+    }
+
+    const glm::mat4& getViewProjectionMatrix() const {
+        updateMatrices();
+        return m_viewProjection;
+    }
+
+    const glm::mat4& getInverseViewMatrix() const {
+        updateMatrices();
+        return m_inverseView;
+    }
+
+    const glm::mat4& getInverseProjectionMatrix() const {
+        updateMatrices();
+        return m_inverseProjection;
     }
 
-    glm::mat4 getProjectionMatrix() const {
-        return glm::perspective(glm::radians(m_fov), m_aspect, m_near, m_far);
+    const glm::mat4& getInverseViewProjectionMatrix() const {
+        updateMatrices();
+        return m_inverseViewProjection;
+    }
+
+    const Frustum& getFrustum() const {
+        updateMatrices();
+        return m_frustum;
+    }
+
+    // Incremented whenever a cached matrix changes: the light clusters are only
+    // reassigned when it moves (or the lights change)
+    unsigned int getMatrixVersion() const {
+        updateMatrices();
+        return m_matrixVersion;
     }
 
 private:
@@ -56,6 +111,30 @@ private:
         m_front = glm::normalize(m_target - m_position);
         m_right = glm::normalize(glm::cross(m_front, glm::vec3(0.0f, 1.0f, 0.0f)));
         m_up = glm::normalize(glm::cross(m_right, m_front));
+        m_viewDirty = true;
+    }
+
+    void updateMatrices() const {
+        if (!m_viewDirty && !m_projectionDirty) return;
+
+        if (m_viewDirty) {
+            m_view = glm::lookAt(m_position, m_target, m_up);
+            // Rigid transform: the inverse is the transposed rotation and the eye position
+            m_inverseView = glm::mat4(glm::transpose(glm::mat3(m_view)));
+            m_inverseView[3] = glm::vec4(m_position, 1.0f);
+        }
+        if (m_projectionDirty) {
+            m_projection = glm::perspective(glm::radians(m_fov), m_aspect, m_near, m_far);
+            m_inverseProjection = glm::inverse(m_projection);
+        }
+
+        m_viewProjection = m_projection * m_view;
+        m_inverseViewProjection = m_inverseView * m_inverseProjection;
+        m_frustum = Frustum::fromMatrix(m_viewProjection);
+
+        m_viewDirty = false;
+        m_projectionDirty = false;
+        ++m_matrixVersion;
     }
 
     glm::vec3 m_position;
@@ -68,4 +147,15 @@ private:
     float m_aspect;
     float m_near;
     float m_far;
-};
\ No newline at end of file
+
+    mutable glm::mat4 m_view{1.0f};
+    mutable glm::mat4 m_projection{1.0f};
+    mutable glm::mat4 m_viewProjection{1.0f};
+    mutable glm::mat4 m_inverseView{1.0f};
+    mutable glm::mat4 m_inverseProjection{1.0f};
+    mutable glm::mat4 m_inverseViewProjection{1.0f};
+    mutable Frustum m_frustum;
+    mutable bool m_viewDirty = true;
+    mutable bool m_projectionDirty = true;
+    mutable unsigned int m_matrixVersion = 0;
+};
@@ -0,0 +1,364 @@
+#include "FrameCapture.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// ===== ENCODAGE PNG MINIMAL =====
+// Deflate en blocs "stored" : aucune dépendance, coût CPU ~ memcpy.
+
+static uint32_t crc32(const unsigned char* data, size_t size, uint32_t crc = 0) {
+    static uint32_t table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        tableReady = true;
+    }
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static void putU32BE(std::vector<unsigned char>& out, uint32_t v) {
+    out.push_back(static_cast<unsigned char>(v >> 24));
+    out.push_back(static_cast<unsigned char>(v >> 16));
+    out.push_back(static_cast<unsigned char>(v >> 8));
+    out.push_back(static_cast<unsigned char>(v));
+}
+
+static void writeChunk(std::ofstream& file, const char type[4], const std::vector<unsigned char>& data) {
+    std::vector<unsigned char> chunk;
+    chunk.reserve(data.size() + 12);
+    putU32BE(chunk, static_cast<uint32_t>(data.size()));
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    putU32BE(chunk, crc32(chunk.data() + 4, data.size() + 4));
+    file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+}
+
+static bool writePNG(const std::string& path, const unsigned char* rgba, int width, int height) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    file.write(reinterpret_cast<const char*>(signature), 8);
+
+    std::vector<unsigned char> ihdr;
+    putU32BE(ihdr, width);
+    putU32BE(ihdr, height);
+    ihdr.push_back(8);   // bit depth
+    ihdr.push_back(2);   // color type RGB
+    ihdr.push_back(0);   // compression
+    ihdr.push_back(0);   // filter
+    ihdr.push_back(0);   // interlace
+    writeChunk(file, "IHDR", ihdr);
+
+    // Scanlines RGB avec octet de filtre 0, lignes retournées (GL = bas en haut)
+    const size_t rowSize = static_cast<size_t>(width) * 3 + 1;
+    std::vector<unsigned char> raw(rowSize * height);
+    for (int y = 0; y < height; ++y) {
+        const unsigned char* src = rgba + static_cast<size_t>(height - 1 - y) * width * 4;
+        unsigned char* dst = raw.data() + y * rowSize;
+        *dst++ = 0;
+        for (int x = 0; x < width; ++x) {
+            *dst++ = src[x * 4 + 0];
+            *dst++ = src[x * 4 + 1];
+            *dst++ = src[x * 4 + 2];
+        }
+    }
+
+    // zlib : en-tête + blocs stored de 65535 octets max + Adler-32
+    std::vector<unsigned char> idat;
+    idat.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    idat.push_back(0x78);
+    idat.push_back(0x01);
+
+    uint32_t a = 1, b = 0;
+    size_t offset = 0;
+    do {
+        size_t blockSize = std::min<size_t>(65535, raw.size() - offset);
+        bool last = (offset + blockSize == raw.size());
+        idat.push_back(last ? 1 : 0);
+        idat.push_back(static_cast<unsigned char>(blockSize & 0xFF));
+        idat.push_back(static_cast<unsigned char>(blockSize >> 8));
+        idat.push_back(static_cast<unsigned char>(~blockSize & 0xFF));
+        idat.push_back(static_cast<unsigned char>((~blockSize >> 8) & 0xFF));
+        idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+
+        for (size_t i = offset; i < offset + blockSize; ++i) {
+            a = (a + raw[i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        offset += blockSize;
+    } while (offset < raw.size());
+    putU32BE(idat, (b << 16) | a);
+
+    writeChunk(file, "IDAT", idat);
+    writeChunk(file, "IEND", {});
+    return static_cast<bool>(file);
+}
+
+static bool writeRaw(const std::string& path, const unsigned char* rgba, int width, int height) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    const size_t rowBytes = static_cast<size_t>(width) * 4;
+    for (int y = height - 1; y >= 0; --y) {
+        file.write(reinterpret_cast<const char*>(rgba + y * rowBytes), rowBytes);
+    }
+    return static_cast<bool>(file);
+}
+
+static std::string timestamp() {
+    std::time_t now = std::time(nullptr);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y%m%d_%H%M%S", std::localtime(&now));
+    return buffer;
+}
+
+// ===== FRAME CAPTURE =====
+
+FrameCapture::FrameCapture(int ringSize, const std::string& outputDir)
+    : m_slots(std::max(ringSize, 2))
+    , m_nextSlot(0)
+    , m_outputDir(outputDir)
+    , m_format(Format::PNG)
+    , m_screenshotRequested(false)
+    , m_recording(false)
+    , m_sequenceFrame(0)
+    , m_screenshotCount(0)
+    , m_framesWritten(0)
+    , m_framesDropped(0)
+    , m_busy(false)
+    , m_stop(false)
+{
+    for (auto& slot : m_slots) {
+        glGenBuffers(1, &slot.pbo);
+    }
+    m_worker = std::thread(&FrameCapture::workerLoop, this);
+}
+
+FrameCapture::~FrameCapture() {
+    flush();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_queueCondition.notify_all();
+    m_worker.join();
+
+    for (auto& slot : m_slots) {
+        glDeleteBuffers(1, &slot.pbo);
+    }
+}
+
+void FrameCapture::requestScreenshot() {
+    m_screenshotRequested = true;
+}
+
+void FrameCapture::startSequence() {
+    m_sequenceDir = m_outputDir + "/sequence_" + timestamp();
+    std::filesystem::create_directories(m_sequenceDir);
+    m_sequenceFrame = 0;
+    m_recording = true;
+    std::cout << "[Capture] Recording to " << m_sequenceDir << std::endl;
+}
+
+void FrameCapture::stopSequence() {
+    if (!m_recording) return;
+    m_recording = false;
+    std::cout << "[Capture] Stopped after " << m_sequenceFrame << " frames" << std::endl;
+}
+
+std::string FrameCapture::nextPath(CaptureKind kind) {
+    const char* ext = (m_format == Format::PNG) ? ".png" : ".rgba";
+    char name[64];
+
+    if (kind == CaptureKind::SEQUENCE) {
+        std::snprintf(name, sizeof(name), "/frame_%06d", m_sequenceFrame++);
+        return m_sequenceDir + name + ext;
+    }
+
+    std::filesystem::create_directories(m_outputDir);
+    std::snprintf(name, sizeof(name), "_%03d", m_screenshotCount++);
+    return m_outputDir + "/screenshot_" + timestamp() + name + ext;
+}
+
+void FrameCapture::captureFrame(int width, int height) {
+    // Récupère d'abord les lectures terminées (sans attendre)
+    for (auto& slot : m_slots) {
+        if (slot.fence) retireSlot(slot, false);
+    }
+
+    if (!m_screenshotRequested && !m_recording) return;
+
+    Slot& slot = m_slots[m_nextSlot];
+    if (slot.fence && !retireSlot(slot, true)) {
+        // Anneau plein et slot non récupérable (GPU bloqué ou file d'écriture pleine) :
+        // cette frame est perdue, le slot garde sa lecture ; aucun nom n'est consommé
+        // (pas de trou dans la séquence) et un screenshot demandé reste en attente
+        ++m_framesDropped;
+        return;
+    }
+
+    size_t size = static_cast<size_t>(width) * height * 4;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.width = width;
+    slot.height = height;
+    slot.paths.clear();
+    if (m_recording) slot.paths.push_back(nextPath(CaptureKind::SEQUENCE));
+    if (m_screenshotRequested) slot.paths.push_back(nextPath(CaptureKind::SCREENSHOT));
+
+    m_nextSlot = (m_nextSlot + 1) % static_cast<int>(m_slots.size());
+    m_screenshotRequested = false;
+}
+
+bool FrameCapture::retireSlot(Slot& slot, bool wait) {
+    {
+        // File bornée : la frame attend dans son PBO plutôt qu'en copie mémoire
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_queue.size() + slot.paths.size() > MAX_QUEUED_JOBS) return false;
+    }
+
+    GLuint64 timeout = wait ? 1000000000ull : 0;  // 1 s max en mode bloquant
+    GLenum status = glClientWaitSync(slot.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, timeout);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        return false;
+    }
+
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+
+    size_t size = static_cast<size_t>(slot.width) * slot.height * 4;
+
+    Job job;
+    job.width = slot.width;
+    job.height = slot.height;
+    job.format = m_format;
+    job.pixels.resize(size);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+    void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (mapped) {
+        std::memcpy(job.pixels.data(), mapped, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!mapped) {
+        std::cerr << "[Capture] Failed to map PBO for " << slot.paths.front() << std::endl;
+        return true;
+    }
+
+    {
+        // Un job par fichier ; les pixels ne sont copiés que si la frame sert deux captures
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i + 1 < slot.paths.size(); ++i) {
+            m_queue.push_back(job);
+            m_queue.back().path = slot.paths[i];
+        }
+        job.path = slot.paths.back();
+        m_queue.push_back(std::move(job));
+    }
+    m_queueCondition.notify_one();
+    return true;
+}
+
+void FrameCapture::dropSlot(Slot& slot, const char* reason) {
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    for (const auto& path : slot.paths) {
+        std::cerr << "[Capture] Dropped " << path << " (" << reason << ")" << std::endl;
+    }
+    ++m_framesDropped;
+}
+
+void FrameCapture::flush() {
+    for (auto& slot : m_slots) {
+        if (!slot.fence) continue;
+
+        // Attend de la place dans la file (le worker écrit), puis la copie GPU
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_idleCondition.wait(lock, [&] { return m_queue.size() + slot.paths.size() <= MAX_QUEUED_JOBS; });
+        }
+        if (!retireSlot(slot, true)) {
+            dropSlot(slot, "GPU readback timed out");
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idleCondition.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+}
+
+bool FrameCapture::hasPendingReadbacks() const {
+    for (const auto& slot : m_slots) {
+        if (slot.fence) return true;
+    }
+    return false;
+}
+
+size_t FrameCapture::getPendingWrites() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size() + (m_busy ? 1 : 0);
+}
+
+size_t FrameCapture::getFramesWritten() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_framesWritten;
+}
+
+void FrameCapture::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_queueCondition.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) return;  // m_stop et plus rien à écrire
+
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_busy = true;
+        }
+
+        const bool written = writeImage(job);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_busy = false;
+            if (written) ++m_framesWritten;
+        }
+        m_idleCondition.notify_all();
+    }
+}
+
+bool FrameCapture::writeImage(const Job& job) {
+    bool ok = (job.format == Format::PNG)
+            ? writePNG(job.path, job.pixels.data(), job.width, job.height)
+            : writeRaw(job.path, job.pixels.data(), job.width, job.height);
+
+    if (!ok) {
+        std::cerr << "[Capture] Failed to write " << job.path << std::endl;
+    }
+    return ok;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class FrameCapture
+ * @brief Capture de frames asynchrone (screenshots et séquences d'images)
+ *
+ * - glReadPixels vers un anneau de Pixel Buffer Objects : la copie GPU -> PBO
+ *   est asynchrone, le CPU ne mappe un PBO que lorsque son fence est signalé
+ *   (quelques frames plus tard), donc pas de stall du pipeline
+ * - Encodage PNG/RAW et écriture disque sur un thread worker
+ * - File d'écriture bornée (MAX_QUEUED_JOBS) : si le disque ne suit pas, les
+ *   frames restent dans leur PBO puis sont abandonnées (getFramesDropped)
+ *   au lieu d'accumuler des copies en mémoire
+ */
+class FrameCapture {
+public:
+    static constexpr size_t MAX_QUEUED_JOBS = 4;   // images copiées en attente d'écriture
+
+    enum class Format {
+        PNG,    // RGB 8 bits, deflate "stored" (pas de compression, encodage rapide)
+        RAW     // RGBA 8 bits brut, lignes de haut en bas
+    };
+
+    /**
+     * @param ringSize Nombre de PBOs (latence de lecture en frames)
+     * @param outputDir Dossier de sortie (créé si besoin)
+     */
+    explicit FrameCapture(int ringSize = 3, const std::string& outputDir = "captures");
+    ~FrameCapture();
+
+    // Non-copiable (PBOs + thread)
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    /**
+     * @brief Capture la prochaine frame dans un fichier unique
+     */
+    void requestScreenshot();
+
+    /**
+     * @brief Démarre/arrête l'enregistrement de toutes les frames dans un sous-dossier
+     */
+    void startSequence();
+    void stopSequence();
+    bool isRecording() const { return m_recording; }
+
+    void setFormat(Format format) { m_format = format; }
+    Format getFormat() const { return m_format; }
+
+    /**
+     * @brief À appeler une fois par frame, framebuffer de lecture lié
+     * Lance la lecture de la frame courante si une capture est demandée,
+     * et récupère les PBOs dont la copie GPU est terminée.
+     */
+    void captureFrame(int width, int height);
+
+    /**
+     * @brief Termine toutes les lectures en cours et attend l'écriture disque
+     */
+    void flush();
+
+    size_t getPendingWrites() const;
+
+    /**
+     * @brief Vrai si des lectures PBO attendent encore d'être récupérées par captureFrame()
+     */
+    bool hasPendingReadbacks() const;
+    size_t getFramesWritten() const;
+
+    /**
+     * @brief Frames demandées mais jamais écrites (GPU ou disque trop en retard)
+     */
+    size_t getFramesDropped() const { return m_framesDropped; }
+
+private:
+    struct Slot {
+        GLuint pbo = 0;
+        GLsync fence = nullptr;
+        int width = 0;
+        int height = 0;
+        std::vector<std::string> paths;   // un fichier par capture servie par cette lecture
+    };
+
+    struct Job {
+        std::vector<unsigned char> pixels;  // RGBA, origine en bas à gauche (GL)
+        int width;
+        int height;
+        std::string path;
+        Format format;
+    };
+
+    /**
+     * @brief Mappe un PBO terminé et envoie les pixels au worker
+     * @param wait Bloque jusqu'à la fin de la copie GPU si nécessaire (1 s max)
+     * @return true si le slot a été vidé ; false si la copie n'est pas terminée
+     * ou si la file d'écriture est pleine (le slot reste en attente)
+     */
+    bool retireSlot(Slot& slot, bool wait);
+
+    /**
+     * @brief Abandonne la lecture d'un slot (fence supprimé, fichiers comptés perdus)
+     */
+    void dropSlot(Slot& slot, const char* reason);
+
+    void workerLoop();
+
+    /**
+     * @return false si l'écriture a échoué (non comptée dans getFramesWritten)
+     */
+    static bool writeImage(const Job& job);
+
+    // Destination d'une capture : passée explicitement, une même frame pouvant
+    // servir un screenshot (F12) pendant un enregistrement
+    enum class CaptureKind {
+        SCREENSHOT,
+        SEQUENCE
+    };
+
+    std::string nextPath(CaptureKind kind);
+
+    std::vector<Slot> m_slots;
+    int m_nextSlot;
+
+    std::string m_outputDir;
+    std::string m_sequenceDir;
+    Format m_format;
+
+    bool m_screenshotRequested;
+    bool m_recording;
+    int m_sequenceFrame;
+    int m_screenshotCount;
+    size_t m_framesWritten;
+    size_t m_framesDropped;     // thread principal seulement
+
+    // Worker
+    std::thread m_worker;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_queueCondition;
+    std::condition_variable m_idleCondition;
+    std::deque<Job> m_queue;
+    bool m_busy;
+    bool m_stop;
+};
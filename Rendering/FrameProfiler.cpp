@@ -0,0 +1,173 @@
+#include "FrameProfiler.h"
+#include <algorithm>
+
+FrameProfiler::FrameProfiler(bool gpuTimers)
+    : m_gpuTimers(gpuTimers)
+    , m_frameIndex(0)
+    , m_cpuFrameTotal(0.0f)
+    , m_cpuFrameWork(0.0f)
+    , m_frameStarted(false)
+{
+    m_scratch.reserve(HISTORY_SIZE);
+
+    for (int b = 0; b < QUERY_BUFFERS; ++b) {
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            m_queries[b][p] = 0;
+            m_queryIssued[b][p] = false;
+        }
+        if (m_gpuTimers) {
+            glGenQueries(PHASE_COUNT, m_queries[b]);
+        }
+    }
+}
+
+FrameProfiler::~FrameProfiler() {
+    if (m_gpuTimers) {
+        for (int b = 0; b < QUERY_BUFFERS; ++b) {
+            glDeleteQueries(PHASE_COUNT, m_queries[b]);
+        }
+    }
+}
+
+const char* FrameProfiler::getPhaseName(Phase phase) {
+    switch (phase) {
+        case Phase::INPUT:     return "Input";
+        case Phase::PICKING:   return "Picking";
+        case Phase::ANIMATION: return "Animation";
+        case Phase::SCENE:     return "Scene";
+        case Phase::IMGUI:     return "ImGui";
+        case Phase::SWAP:      return "Swap";
+        default:               return "Unknown";
+    }
+}
+
+void FrameProfiler::beginFrame() {
+    Clock::time_point now = Clock::now();
+
+    // Durée totale = début de frame à début de frame
+    if (m_frameStarted) {
+        float frameMs = std::chrono::duration<float, std::milli>(now - m_frameStart).count();
+        m_frameHistory.push(frameMs);
+    }
+    m_frameStart = now;
+    m_frameStarted = true;
+    m_cpuFrameTotal = 0.0f;
+    m_cpuFrameWork = 0.0f;
+
+    if (m_gpuTimers) {
+        // Le buffer réutilisé ici contient les requêtes émises il y a QUERY_BUFFERS frames
+        collectGpuResults(m_frameIndex % QUERY_BUFFERS);
+    }
+}
+
+void FrameProfiler::endFrame() {
+    m_cpuTotalHistory.push(m_cpuFrameTotal);
+    m_cpuWorkHistory.push(m_cpuFrameWork);
+    ++m_frameIndex;
+
+    // Une fois par frame, après la dernière phase : le HUD ne fait que lire
+    updateStats();
+}
+
+void FrameProfiler::beginPhase(Phase phase) {
+    int p = index(phase);
+    m_phaseStart[p] = Clock::now();
+
+    if (m_gpuTimers) {
+        int buffer = m_frameIndex % QUERY_BUFFERS;
+        glBeginQuery(GL_TIME_ELAPSED, m_queries[buffer][p]);
+        m_queryIssued[buffer][p] = true;
+    }
+}
+
+void FrameProfiler::endPhase(Phase phase) {
+    int p = index(phase);
+
+    if (m_gpuTimers) {
+        glEndQuery(GL_TIME_ELAPSED);
+    }
+
+    float ms = std::chrono::duration<float, std::milli>(Clock::now() - m_phaseStart[p]).count();
+    m_cpuHistory[p].push(ms);
+    m_cpuFrameTotal += ms;
+    if (phase != Phase::SWAP) m_cpuFrameWork += ms;
+}
+
+void FrameProfiler::collectGpuResults(int buffer) {
+    float ms[PHASE_COUNT] = {};
+    bool issued[PHASE_COUNT] = {};
+    bool complete = true;
+    bool any = false;
+
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        if (!m_queryIssued[buffer][p]) continue;
+        issued[p] = true;
+        any = true;
+
+        GLint available = 0;
+        glGetQueryObjectiv(m_queries[buffer][p], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            GLuint64 ns = 0;
+            glGetQueryObjectui64v(m_queries[buffer][p], GL_QUERY_RESULT, &ns);
+            ms[p] = static_cast<float>(ns) * 1e-6f;
+        } else {
+            complete = false;
+        }
+        m_queryIssued[buffer][p] = false;
+    }
+
+    // Une requête non disponible : toute la frame est perdue plutôt que de
+    // bloquer ou de mélanger des totaux partiels aux totaux complets
+    if (!any || !complete) return;
+
+    float total = 0.0f;
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        if (!issued[p]) continue;
+        m_gpuHistory[p].push(ms[p]);
+        total += ms[p];
+    }
+    m_gpuTotalHistory.push(total);
+    m_gpuWorkHistory.push(total - ms[index(Phase::SWAP)]);
+}
+
+FrameProfiler::Stats FrameProfiler::computeStats(const History& history) {
+    m_scratch.assign(history.samples.begin(), history.samples.begin() + history.count);
+    return summarizeInPlace(m_scratch);
+}
+
+void FrameProfiler::updateStats() {
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        m_cpuStats[p] = computeStats(m_cpuHistory[p]);
+        m_gpuStats[p] = computeStats(m_gpuHistory[p]);
+    }
+    m_frameStats = computeStats(m_frameHistory);
+    m_cpuTotalStats = computeStats(m_cpuTotalHistory);
+    m_gpuTotalStats = computeStats(m_gpuTotalHistory);
+    m_cpuWorkStats = computeStats(m_cpuWorkHistory);
+    m_gpuWorkStats = computeStats(m_gpuWorkHistory);
+}
+
+FrameProfiler::Stats FrameProfiler::summarize(std::vector<float> samples) {
+    return summarizeInPlace(samples);
+}
+
+FrameProfiler::Stats FrameProfiler::summarizeInPlace(std::vector<float>& samples) {
+    Stats stats;
+    if (samples.empty()) return stats;
+
+    std::sort(samples.begin(), samples.end());
+
+    float sum = 0.0f;
+    for (float v : samples) sum += v;
+
+    auto percentile = [&](float q) {
+        size_t i = static_cast<size_t>(q * (samples.size() - 1) + 0.5f);
+        return samples[std::min(i, samples.size() - 1)];
+    };
+
+    stats.avg = sum / samples.size();
+    stats.p95 = percentile(0.95f);
+    stats.p99 = percentile(0.99f);
+    stats.max = samples.back();
+    return stats;
+}
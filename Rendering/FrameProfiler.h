@@ -0,0 +1,175 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <array>
+#include <chrono>
+#include <vector>
+
+/**
+ * @class FrameProfiler
+ * @brief Profileur par phase de frame (CPU + GPU)
+ *
+ * - CPU : timestamps steady_clock au début/fin de chaque phase
+ * - GPU : requêtes GL_TIME_ELAPSED sur QUERY_BUFFERS = 2 jeux ; un jeu est
+ *   relu au début de la frame qui le réutilise, donc les résultats ont deux
+ *   frames de retard ; si une seule requête du jeu n'est pas prête, toute la
+ *   frame GPU est abandonnée (jamais de blocage, jamais de total partiel)
+ * - Historique glissant par phase : moyenne, p95, p99, max, recalculés une
+ *   fois par frame dans endFrame() (hors de toute phase mesurée)
+ * - Totaux "travail" sans Swap, CPU et GPU sur la même définition, pour
+ *   juger si la frame est limitée par le CPU ou le GPU
+ *
+ * Les phases doivent être séquentielles (GL_TIME_ELAPSED ne s'imbrique pas).
+ */
+class FrameProfiler {
+public:
+    enum class Phase {
+        INPUT,
+        PICKING,
+        ANIMATION,
+        SCENE,
+        IMGUI,
+        SWAP,
+        COUNT
+    };
+
+    struct Stats {
+        float avg = 0.0f;
+        float p95 = 0.0f;
+        float p99 = 0.0f;
+        float max = 0.0f;
+    };
+
+    static constexpr int PHASE_COUNT = static_cast<int>(Phase::COUNT);
+    static constexpr int HISTORY_SIZE = 240;
+
+    /**
+     * @param gpuTimers Active les requêtes GL (contexte GL courant requis)
+     */
+    explicit FrameProfiler(bool gpuTimers = true);
+    ~FrameProfiler();
+
+    // Non-copiable (requêtes GPU)
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    void beginFrame();
+    void endFrame();
+
+    /**
+     * @brief Itération sans rendu (rendu à la demande) : l'attente n'entre
+     * pas dans la durée de la prochaine frame
+     */
+    void skipFrame() { m_frameStarted = false; }
+
+    void beginPhase(Phase phase);
+    void endPhase(Phase phase);
+
+    /**
+     * @brief RAII : beginPhase/endPhase sur une portée
+     */
+    class Scope {
+    public:
+        Scope(FrameProfiler& profiler, Phase phase) : m_profiler(profiler), m_phase(phase) {
+            m_profiler.beginPhase(m_phase);
+        }
+        ~Scope() { m_profiler.endPhase(m_phase); }
+    private:
+        FrameProfiler& m_profiler;
+        Phase m_phase;
+    };
+
+    // Statistiques en millisecondes sur l'historique glissant (état du dernier endFrame())
+    const Stats& getCpuStats(Phase phase) const { return m_cpuStats[index(phase)]; }
+    const Stats& getGpuStats(Phase phase) const { return m_gpuStats[index(phase)]; }
+    const Stats& getFrameStats() const { return m_frameStats; }
+    const Stats& getCpuTotalStats() const { return m_cpuTotalStats; }
+    const Stats& getGpuTotalStats() const { return m_gpuTotalStats; }
+
+    // Toutes les phases sauf Swap (attente vsync / GPU), frame par frame
+    const Stats& getCpuWorkStats() const { return m_cpuWorkStats; }
+    const Stats& getGpuWorkStats() const { return m_gpuWorkStats; }
+
+    /**
+     * @brief Historique brut des durées de frame (pour ImGui::PlotLines)
+     * @param outOffset Index de l'échantillon le plus ancien
+     */
+    const float* getFrameHistory(int& outOffset) const {
+        outOffset = m_frameHistory.next;
+        return m_frameHistory.samples.data();
+    }
+
+    bool hasGpuTimers() const { return m_gpuTimers; }
+
+    /**
+     * @brief Moyenne/percentiles d'une série arbitraire (ex: run de benchmark complet)
+     */
+    static Stats summarize(std::vector<float> samples);
+
+    static const char* getPhaseName(Phase phase);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Anneau de N échantillons
+    struct History {
+        std::array<float, HISTORY_SIZE> samples{};
+        int next = 0;
+        int count = 0;
+
+        void push(float value) {
+            samples[next] = value;
+            next = (next + 1) % HISTORY_SIZE;
+            if (count < HISTORY_SIZE) ++count;
+        }
+    };
+
+    static constexpr int QUERY_BUFFERS = 2;
+
+    static int index(Phase phase) { return static_cast<int>(phase); }
+
+    /**
+     * @brief Trie samples sur place puis en extrait moyenne et percentiles
+     */
+    static Stats summarizeInPlace(std::vector<float>& samples);
+
+    // Via m_scratch : aucune allocation par appel
+    Stats computeStats(const History& history);
+    void updateStats();
+
+    /**
+     * @brief Récupère les requêtes GPU du jeu de buffers donné (si disponibles)
+     */
+    void collectGpuResults(int buffer);
+
+    bool m_gpuTimers;
+    int m_frameIndex;
+
+    // Requêtes [buffer][phase] + phases réellement émises dans ce buffer
+    GLuint m_queries[QUERY_BUFFERS][PHASE_COUNT];
+    bool m_queryIssued[QUERY_BUFFERS][PHASE_COUNT];
+
+    Clock::time_point m_frameStart;
+    Clock::time_point m_phaseStart[PHASE_COUNT];
+    float m_cpuFrameTotal;
+    float m_cpuFrameWork;       // m_cpuFrameTotal sans Swap
+    bool m_frameStarted;
+
+    History m_cpuHistory[PHASE_COUNT];
+    History m_gpuHistory[PHASE_COUNT];
+    History m_frameHistory;
+    History m_cpuTotalHistory;
+    History m_gpuTotalHistory;
+    History m_cpuWorkHistory;
+    History m_gpuWorkHistory;
+
+    // Statistiques mises en cache par endFrame()
+    Stats m_cpuStats[PHASE_COUNT];
+    Stats m_gpuStats[PHASE_COUNT];
+    Stats m_frameStats;
+    Stats m_cpuTotalStats;
+    Stats m_gpuTotalStats;
+    Stats m_cpuWorkStats;
+    Stats m_gpuWorkStats;
+    std::vector<float> m_scratch;
+};
@@ -0,0 +1,121 @@
+#pragma once
+#include <glm/glm.hpp>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MANCALA_FRUSTUM_SSE 1
+#include <xmmintrin.h>
+#endif
+
+/**
+ * @brief Pyramide de vue (6 plans) pour le frustum culling
+ *
+ * Plans extraits de la matrice projection * view (méthode Gribb/Hartmann),
+ * stockés en SoA (nx[], ny[], nz[], d[]) pour tester 4 plans par instruction SSE.
+ * Les plans 6 et 7 sont des plans de remplissage toujours satisfaits.
+ */
+class Frustum {
+public:
+    Frustum() {
+        for (int i = 0; i < 8; ++i) {
+            m_nx[i] = m_ny[i] = m_nz[i] = 0.0f;
+            m_ax[i] = m_ay[i] = m_az[i] = 0.0f;
+            m_d[i] = 1.0f;
+        }
+    }
+
+    /**
+     * @brief Construit le frustum depuis projection * view
+     */
+    static Frustum fromMatrix(const glm::mat4& viewProj) {
+        Frustum f;
+
+        // Lignes de la matrice (GLM est column-major : m[col][row])
+        glm::vec4 row0(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+        glm::vec4 row1(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+        glm::vec4 row2(viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2]);
+        glm::vec4 row3(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+
+        const glm::vec4 planes[6] = {
+            row3 + row0,   // Left
+            row3 - row0,   // Right
+            row3 + row1,   // Bottom
+            row3 - row1,   // Top
+            row3 + row2,   // Near
+            row3 - row2    // Far
+        };
+
+        for (int i = 0; i < 6; ++i) {
+            glm::vec4 p = planes[i] / glm::length(glm::vec3(planes[i]));
+            f.m_nx[i] = p.x;
+            f.m_ny[i] = p.y;
+            f.m_nz[i] = p.z;
+            f.m_d[i]  = p.w;
+            f.m_ax[i] = glm::abs(p.x);
+            f.m_ay[i] = glm::abs(p.y);
+            f.m_az[i] = glm::abs(p.z);
+        }
+        return f;
+    }
+
+    /**
+     * @brief Teste une boîte (centre + demi-extensions) contre les 6 plans
+     * @return false si la boîte est entièrement hors d'un plan
+     */
+    bool intersectsBox(const glm::vec3& center, const glm::vec3& extent) const {
+#ifdef MANCALA_FRUSTUM_SSE
+        const __m128 cx = _mm_set1_ps(center.x);
+        const __m128 cy = _mm_set1_ps(center.y);
+        const __m128 cz = _mm_set1_ps(center.z);
+        const __m128 ex = _mm_set1_ps(extent.x);
+        const __m128 ey = _mm_set1_ps(extent.y);
+        const __m128 ez = _mm_set1_ps(extent.z);
+
+        __m128 outside = _mm_setzero_ps();
+        for (int i = 0; i < 8; i += 4) {
+            // distance(centre) + rayon projeté de la boîte sur la normale
+            __m128 dist = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(cx, _mm_load_ps(m_nx + i)),
+                           _mm_mul_ps(cy, _mm_load_ps(m_ny + i))),
+                _mm_add_ps(_mm_mul_ps(cz, _mm_load_ps(m_nz + i)),
+                           _mm_load_ps(m_d + i)));
+            __m128 radius = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(ex, _mm_load_ps(m_ax + i)),
+                           _mm_mul_ps(ey, _mm_load_ps(m_ay + i))),
+                _mm_mul_ps(ez, _mm_load_ps(m_az + i)));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(dist, radius), _mm_setzero_ps()));
+        }
+        return _mm_movemask_ps(outside) == 0;
+#else
+        for (int i = 0; i < 6; ++i) {
+            float dist = center.x * m_nx[i] + center.y * m_ny[i] + center.z * m_nz[i] + m_d[i];
+            float radius = extent.x * m_ax[i] + extent.y * m_ay[i] + extent.z * m_az[i];
+            if (dist + radius < 0.0f) return false;
+        }
+        return true;
+#endif
+    }
+
+    bool intersectsAABB(const glm::vec3& min, const glm::vec3& max) const {
+        return intersectsBox((min + max) * 0.5f, (max - min) * 0.5f);
+    }
+
+    bool intersectsSphere(const glm::vec3& center, float radius) const {
+        for (int i = 0; i < 6; ++i) {
+            float dist = center.x * m_nx[i] + center.y * m_ny[i] + center.z * m_nz[i] + m_d[i];
+            if (dist < -radius) return false;
+        }
+        return true;
+    }
+
+private:
+    alignas(16) float m_nx[8];
+    alignas(16) float m_ny[8];
+    alignas(16) float m_nz[8];
+    alignas(16) float m_d[8];
+
+    // |normale| précalculée (rayon projeté de la boîte)
+    alignas(16) float m_ax[8];
+    alignas(16) float m_ay[8];
+    alignas(16) float m_az[8];
+};
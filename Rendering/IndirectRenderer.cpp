@@ -0,0 +1,245 @@
+#include "IndirectRenderer.h"
+#include "Scene/GameObject.h"
+#include "MeshLOD.h"
+#include "TextureManager.h"
+#include "shader.h"
+#include <algorithm>
+#include <cstdint>
+
+// Binding SSBO attendu par phong_mdi.vs/.fs
+static constexpr GLuint DRAW_DATA_BINDING = 0;
+// Attribut d'instance portant le draw ID
+static constexpr GLuint DRAW_ID_LOCATION = 3;
+
+IndirectRenderer::IndirectRenderer()
+    : m_VAO(0), m_VBO(0), m_EBO(0)
+    , m_drawIdVBO(0), m_commandBuffer(0), m_drawDataSSBO(0)
+    , m_indexType(GL_UNSIGNED_SHORT)
+    , m_drawCapacity(0)
+    , m_vertexCapacity(0)
+    , m_indexCapacity(0)
+{
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+    glGenBuffers(1, &m_EBO);
+    glGenBuffers(1, &m_drawIdVBO);
+    glGenBuffers(1, &m_commandBuffer);
+    glGenBuffers(1, &m_drawDataSSBO);
+
+    glBindVertexArray(m_VAO);
+
+    // Même layout que Mesh::setupMesh
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+                          (void*)offsetof(Vertex, texCoords));
+
+    // Draw ID : une valeur par instance, indexée par baseInstance
+    glBindBuffer(GL_ARRAY_BUFFER, m_drawIdVBO);
+    glEnableVertexAttribArray(DRAW_ID_LOCATION);
+    glVertexAttribIPointer(DRAW_ID_LOCATION, 1, GL_UNSIGNED_INT, sizeof(GLuint), (void*)0);
+    glVertexAttribDivisor(DRAW_ID_LOCATION, 1);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+
+    glBindVertexArray(0);
+}
+
+IndirectRenderer::~IndirectRenderer() {
+    glDeleteVertexArrays(1, &m_VAO);
+    glDeleteBuffers(1, &m_VBO);
+    glDeleteBuffers(1, &m_EBO);
+    glDeleteBuffers(1, &m_drawIdVBO);
+    glDeleteBuffers(1, &m_commandBuffer);
+    glDeleteBuffers(1, &m_drawDataSSBO);
+}
+
+bool IndirectRenderer::appendMesh(const Mesh* mesh) {
+    if (!mesh || m_meshRanges.count(mesh->getId())) return false;
+
+    MeshRange range;
+    range.firstIndex = static_cast<GLuint>(m_arenaIndices.size());
+    range.indexCount = static_cast<GLuint>(mesh->getIndices().size());
+    range.baseVertex = static_cast<GLint>(m_arenaVertices.size());
+    m_meshRanges[mesh->getId()] = range;
+
+    m_arenaVertices.insert(m_arenaVertices.end(), mesh->getVertices().begin(), mesh->getVertices().end());
+    m_arenaIndices.insert(m_arenaIndices.end(), mesh->getIndices().begin(), mesh->getIndices().end());
+    return true;
+}
+
+void IndirectRenderer::registerObjects(const std::vector<GameObject*>& objects) {
+    const size_t firstVertex = m_arenaVertices.size();
+    const size_t firstIndex = m_arenaIndices.size();
+
+    for (const GameObject* obj : objects) {
+        const Mesh* mesh = obj ? obj->getMesh() : nullptr;
+        if (!mesh || m_meshRanges.count(mesh->getId())) continue;
+
+        // Toute la chaîne d'un coup : un changement de LOD ne trouve jamais de mesh inconnu
+        if (const MeshLOD* lod = obj->getLOD()) {
+            for (size_t level = 0; level < lod->getLevelCount(); ++level) {
+                appendMesh(lod->getLevel(static_cast<int>(level)).mesh.get());
+            }
+        }
+        appendMesh(mesh);
+    }
+
+    if (m_arenaIndices.size() != firstIndex || m_arenaVertices.size() != firstVertex) {
+        uploadArena(firstVertex, firstIndex);
+    }
+}
+
+void IndirectRenderer::uploadArena(size_t firstVertex, size_t firstIndex) {
+    glBindVertexArray(m_VAO);
+
+    // Ajout seulement : la partie déjà sur le GPU n'est renvoyée que si le buffer doit grandir
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    if (m_arenaVertices.size() > m_vertexCapacity) {
+        m_vertexCapacity = std::max(m_arenaVertices.size(), m_vertexCapacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, m_vertexCapacity * sizeof(Vertex), nullptr, GL_STATIC_DRAW);
+        firstVertex = 0;
+    }
+    glBufferSubData(GL_ARRAY_BUFFER,
+                    firstVertex * sizeof(Vertex),
+                    (m_arenaVertices.size() - firstVertex) * sizeof(Vertex),
+                    m_arenaVertices.data() + firstVertex);
+
+    // Indices locaux à chaque mesh (baseVertex) : 16 bits suffisent si aucun mesh ne dépasse 65536 vertices
+    bool fits16 = std::all_of(m_arenaIndices.begin() + firstIndex, m_arenaIndices.end(),
+                              [](unsigned int index) { return index <= 0xFFFFu; });
+    if (m_indexType == GL_UNSIGNED_SHORT && !fits16) {
+        // Passage en 32 bits : tout l'EBO est réécrit
+        m_indexType = GL_UNSIGNED_INT;
+        m_indexCapacity = 0;
+    }
+    const size_t indexSize = (m_indexType == GL_UNSIGNED_SHORT) ? sizeof(uint16_t) : sizeof(unsigned int);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+    if (m_arenaIndices.size() > m_indexCapacity) {
+        m_indexCapacity = std::max(m_arenaIndices.size(), m_indexCapacity * 2);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indexCapacity * indexSize, nullptr, GL_STATIC_DRAW);
+        firstIndex = 0;
+    }
+    const size_t count = m_arenaIndices.size() - firstIndex;
+    if (m_indexType == GL_UNSIGNED_SHORT) {
+        std::vector<uint16_t> shortIndices(m_arenaIndices.begin() + firstIndex, m_arenaIndices.end());
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, firstIndex * indexSize, count * indexSize, shortIndices.data());
+    } else {
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, firstIndex * indexSize, count * indexSize,
+                        m_arenaIndices.data() + firstIndex);
+    }
+
+    glBindVertexArray(0);
+}
+
+void IndirectRenderer::ensureDrawCapacity(size_t count) {
+    if (count <= m_drawCapacity) return;
+
+    size_t capacity = std::max<size_t>(count, m_drawCapacity * 2);
+    std::vector<GLuint> ids(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        ids[i] = static_cast<GLuint>(i);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_drawIdVBO);
+    glBufferData(GL_ARRAY_BUFFER, ids.size() * sizeof(GLuint), ids.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_drawCapacity = capacity;
+}
+
+void IndirectRenderer::render(const std::vector<GameObject*>& objects, Shader& untexturedProgram,
+                              Shader* texturedProgram) {
+    // Normalement déjà enregistrés (registerObjects sur toute la scène) : simple vérification
+    registerObjects(objects);
+
+    m_commands.clear();
+    m_drawData.clear();
+    m_batches.clear();
+
+    // Regrouper par texture (placeholder inclus) : un changement de binding par lot
+    TextureManager& textures = TextureManager::getInstance();
+    m_sorted.clear();
+    for (const GameObject* obj : objects) {
+        if (!obj || !obj->isVisible() || !obj->getMesh()) continue;
+        GLuint texture = (texturedProgram && obj->getTexture()) ? textures.getTextureID(obj->getTexture()) : 0;
+        m_sorted.emplace_back(texture, obj);
+    }
+    std::stable_sort(m_sorted.begin(), m_sorted.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (const auto& entry : m_sorted) {
+        const GameObject* obj = entry.second;
+        if (m_batches.empty() || m_batches.back().texture != entry.first) {
+            m_batches.push_back({ m_commands.size(), 0, entry.first });
+        }
+        ++m_batches.back().commandCount;
+
+        const MeshRange& range = m_meshRanges[obj->getMesh()->getId()];
+        const Material& mat = obj->getMaterial();
+        glm::mat4 model = obj->getTransform().getModelMatrix();
+
+        DrawCommand cmd;
+        cmd.count         = range.indexCount;
+        cmd.instanceCount = 1;
+        cmd.firstIndex    = range.firstIndex;
+        cmd.baseVertex    = range.baseVertex;
+        cmd.baseInstance  = static_cast<GLuint>(m_commands.size());
+        m_commands.push_back(cmd);
+
+        DrawData data;
+        data.model        = model;
+        data.normalMatrix = glm::mat4(obj->getTransform().getNormalMatrix());
+        data.ambient      = glm::vec4(mat.ambient, 1.0f);
+        data.diffuse      = glm::vec4(mat.diffuse, entry.first ? static_cast<float>(obj->getTextureLayer()) : -1.0f);
+        data.specular     = glm::vec4(mat.specular, mat.shininess);
+        m_drawData.push_back(data);
+    }
+
+    if (m_commands.empty()) return;
+
+    ensureDrawCapacity(m_commands.size());
+
+    // Orphaning : évite d'attendre que le GPU ait fini la frame précédente
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_drawDataSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER,
+                 m_drawData.size() * sizeof(DrawData),
+                 m_drawData.data(),
+                 GL_STREAM_DRAW);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, m_drawDataSSBO);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_commandBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER,
+                 m_commands.size() * sizeof(DrawCommand),
+                 m_commands.data(),
+                 GL_STREAM_DRAW);
+
+    glBindVertexArray(m_VAO);
+    const Shader* current = nullptr;
+    for (const Batch& batch : m_batches) {
+        // Lot sans texture : variante sans échantillonnage
+        Shader& program = (batch.texture && texturedProgram) ? *texturedProgram : untexturedProgram;
+        if (&program != current) {
+            program.use();
+            current = &program;
+        }
+        if (batch.texture) {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, batch.texture);
+        }
+        glMultiDrawElementsIndirect(GL_TRIANGLES,
+                                    m_indexType,
+                                    reinterpret_cast<const void*>(batch.firstCommand * sizeof(DrawCommand)),
+                                    static_cast<GLsizei>(batch.commandCount),
+                                    0);
+    }
+    glBindVertexArray(0);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
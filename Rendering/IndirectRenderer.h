@@ -0,0 +1,136 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include "core/Mesh.h"
+#include <unordered_map>
+#include <vector>
+
+class GameObject;
+class Mesh;
+class Shader;
+
+/**
+ * @class IndirectRenderer
+ * @brief Chemin de rendu GL 4.3+ : toute la scène en un seul glMultiDrawElementsIndirect
+ *
+ * - Géométrie de tous les meshes regroupée dans un VBO/EBO partagé (arena),
+ *   en ajout seul : un mesh inconnu (et toute sa chaîne de LOD) est ajouté à la
+ *   fin, les meshes déjà présents ne sont jamais renvoyés ni évincés
+ * - Une commande indirecte par objet visible
+ * - Données par draw (model, normal matrix, matériau) dans un SSBO,
+ *   lues dans le shader via un attribut d'instance "draw ID" (baseInstance)
+ * - Commandes triées par tableau de textures : un appel MDI par tableau
+ *   (un seul par thème), la couche voyage dans les données par draw
+ *
+ * Le chemin Mesh/GameObject classique reste le fallback GL 3.3.
+ */
+class IndirectRenderer {
+public:
+    IndirectRenderer();
+    ~IndirectRenderer();
+
+    // Non-copiable (ressources GPU)
+    IndirectRenderer(const IndirectRenderer&) = delete;
+    IndirectRenderer& operator=(const IndirectRenderer&) = delete;
+
+    /**
+     * @brief Vérifie que le contexte fournit MDI + SSBO (GL 4.3)
+     */
+    static bool isSupported(int glMajor, int glMinor) {
+        return glMajor > 4 || (glMajor == 4 && glMinor >= 3);
+    }
+
+    /**
+     * @brief Ajoute à l'arena les meshes (et niveaux de LOD) pas encore connus
+     * À appeler sur toute la scène, avant culling : un objet qui revient dans le
+     * frustum ou change de LOD ne déclenche aucun envoi.
+     */
+    void registerObjects(const std::vector<GameObject*>& objects);
+
+    /**
+     * @brief Soumet tous les objets visibles en un seul appel par lot
+     * Variantes "phong_mdi" avec leurs uniformes de frame déjà appliqués :
+     * untexturedProgram pour les lots sans texture, texturedProgram pour les
+     * autres (nullptr : textures ignorées, un seul lot).
+     * Un mesh encore inconnu est ajouté à l'arena au passage.
+     */
+    void render(const std::vector<GameObject*>& objects, Shader& untexturedProgram,
+                Shader* texturedProgram);
+
+    size_t getDrawCount() const { return m_commands.size(); }
+    size_t getBatchCount() const { return m_batches.size(); }
+    size_t getMeshCount() const { return m_meshRanges.size(); }
+
+private:
+    // Layout imposé par GL (DrawElementsIndirectCommand)
+    struct DrawCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint  baseVertex;
+        GLuint baseInstance;
+    };
+
+    // Layout std430, doit correspondre à DrawData dans phong_mdi.vs/.fs
+    struct DrawData {
+        glm::mat4 model;
+        glm::mat4 normalMatrix;
+        glm::vec4 ambient;
+        glm::vec4 diffuse;     // w = couche du tableau de textures, < 0 sans texture
+        glm::vec4 specular;    // w = shininess
+    };
+
+    // Suite de commandes partageant la même texture diffuse
+    struct Batch {
+        size_t firstCommand;
+        size_t commandCount;
+        GLuint texture;        // 0 = matériau seul
+    };
+
+    struct MeshRange {
+        GLuint firstIndex;
+        GLuint indexCount;
+        GLint  baseVertex;
+    };
+
+    /**
+     * @brief Ajoute un mesh à la copie CPU de l'arena ; false s'il y est déjà
+     */
+    bool appendMesh(const Mesh* mesh);
+
+    /**
+     * @brief Envoie au GPU la partie de l'arena ajoutée depuis firstVertex / firstIndex
+     * (tout, si un buffer doit grandir ou si les indices passent en 32 bits)
+     */
+    void uploadArena(size_t firstVertex, size_t firstIndex);
+
+    /**
+     * @brief Agrandit le buffer de draw IDs si besoin
+     */
+    void ensureDrawCapacity(size_t count);
+
+    GLuint m_VAO;
+    GLuint m_VBO;
+    GLuint m_EBO;
+    GLuint m_drawIdVBO;
+    GLuint m_commandBuffer;
+    GLuint m_drawDataSSBO;
+    GLenum m_indexType;  // GL_UNSIGNED_SHORT si chaque mesh de l'arène tient sur 16 bits
+
+    size_t m_drawCapacity;
+    size_t m_vertexCapacity;   // taille allouée des buffers de l'arena
+    size_t m_indexCapacity;
+
+    // Copie CPU de l'arena (ajout seul)
+    std::vector<Vertex> m_arenaVertices;
+    std::vector<unsigned int> m_arenaIndices;
+
+    // Clé : Mesh::getId()
+    std::unordered_map<unsigned int, MeshRange> m_meshRanges;
+
+    std::vector<DrawCommand> m_commands;
+    std::vector<DrawData> m_drawData;
+    std::vector<Batch> m_batches;
+    std::vector<std::pair<GLuint, const GameObject*>> m_sorted;
+};
@@ -0,0 +1,228 @@
+#include "LightClusterer.h"
+#include "shader.h"
+#include <algorithm>
+#include <cmath>
+
+static constexpr size_t INITIAL_BUFFER_BYTES = 1024;
+
+LightClusterer::LightClusterer()
+    : m_clusterMin(CLUSTER_COUNT)
+    , m_clusterMax(CLUSTER_COUNT)
+    , m_fovY(0.0f)
+    , m_aspect(0.0f)
+    , m_near(0.0f)
+    , m_far(0.0f)
+    , m_clusterData(CLUSTER_COUNT * 2, 0)
+    , m_cursor(CLUSTER_COUNT, 0)
+    , m_lightCount(0)
+    , m_maxPerCluster(0)
+    , m_activeClusters(0)
+{
+    createBufferTexture(m_lights, GL_RGBA32F);
+    createBufferTexture(m_clusters, GL_RG32UI);
+    createBufferTexture(m_lightIndices, GL_R32UI);
+}
+
+LightClusterer::~LightClusterer() {
+    destroyBufferTexture(m_lights);
+    destroyBufferTexture(m_clusters);
+    destroyBufferTexture(m_lightIndices);
+}
+
+void LightClusterer::createBufferTexture(BufferTexture& target, GLenum format) {
+    target.format = format;
+    target.capacity = INITIAL_BUFFER_BYTES;
+
+    glGenBuffers(1, &target.buffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, target.buffer);
+    glBufferData(GL_TEXTURE_BUFFER, target.capacity, nullptr, GL_STREAM_DRAW);
+
+    glGenTextures(1, &target.texture);
+    glBindTexture(GL_TEXTURE_BUFFER, target.texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, format, target.buffer);
+
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void LightClusterer::destroyBufferTexture(BufferTexture& target) {
+    if (target.texture) glDeleteTextures(1, &target.texture);
+    if (target.buffer) glDeleteBuffers(1, &target.buffer);
+    target.texture = 0;
+    target.buffer = 0;
+}
+
+void LightClusterer::upload(BufferTexture& target, const void* data, size_t size) {
+    if (size == 0) return;
+
+    glBindBuffer(GL_TEXTURE_BUFFER, target.buffer);
+    if (size > target.capacity) {
+        target.capacity = std::max(size, target.capacity * 2);
+    }
+    // Orphelinage : le driver alloue un nouveau stockage si le GPU lit encore l'ancien
+    glBufferData(GL_TEXTURE_BUFFER, target.capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+int LightClusterer::sliceForDepth(float depth) const {
+    if (depth <= m_near) return 0;
+    int slice = static_cast<int>(std::log(depth / m_near) / std::log(m_far / m_near) * GRID_Z);
+    return std::min(std::max(slice, 0), GRID_Z - 1);
+}
+
+void LightClusterer::rebuildClusterBounds(float fovYDegrees, float aspect, float near, float far) {
+    m_fovY = fovYDegrees;
+    m_aspect = aspect;
+    m_near = near;
+    m_far = far;
+
+    const float tanY = std::tan(glm::radians(fovYDegrees) * 0.5f);
+    const float tanX = tanY * aspect;
+
+    for (int z = 0; z < GRID_Z; ++z) {
+        // Tranches exponentielles : taille proportionnelle à la profondeur
+        float dNear = near * std::pow(far / near, static_cast<float>(z) / GRID_Z);
+        float dFar  = near * std::pow(far / near, static_cast<float>(z + 1) / GRID_Z);
+
+        for (int y = 0; y < GRID_Y; ++y) {
+            float ny0 = -1.0f + 2.0f * y / GRID_Y;
+            float ny1 = -1.0f + 2.0f * (y + 1) / GRID_Y;
+
+            for (int x = 0; x < GRID_X; ++x) {
+                float nx0 = -1.0f + 2.0f * x / GRID_X;
+                float nx1 = -1.0f + 2.0f * (x + 1) / GRID_X;
+
+                int c = x + GRID_X * (y + GRID_Y * z);
+                m_clusterMin[c] = glm::vec3(std::min(nx0 * dNear, nx0 * dFar) * tanX,
+                                            std::min(ny0 * dNear, ny0 * dFar) * tanY,
+                                            -dFar);
+                m_clusterMax[c] = glm::vec3(std::max(nx1 * dNear, nx1 * dFar) * tanX,
+                                            std::max(ny1 * dNear, ny1 * dFar) * tanY,
+                                            -dNear);
+            }
+        }
+    }
+}
+
+void LightClusterer::update(const std::vector<PointLight>& lights, const glm::mat4& view,
+                            float fovYDegrees, float aspect, float near, float far) {
+    if (fovYDegrees != m_fovY || aspect != m_aspect || near != m_near || far != m_far) {
+        rebuildClusterBounds(fovYDegrees, aspect, near, far);
+    }
+
+    const float tanY = std::tan(glm::radians(fovYDegrees) * 0.5f);
+    const float tanX = tanY * aspect;
+
+    m_lightCount = lights.size();
+    m_lightData.resize(lights.size() * 2);
+    m_pairCluster.clear();
+    m_pairLight.clear();
+
+    for (size_t i = 0; i < lights.size(); ++i) {
+        const PointLight& light = lights[i];
+        m_lightData[i * 2 + 0] = glm::vec4(light.position, light.radius);
+        m_lightData[i * 2 + 1] = glm::vec4(light.color, light.intensity);
+
+        glm::vec3 p = glm::vec3(view * glm::vec4(light.position, 1.0f));
+        float r = light.radius;
+        float depth = -p.z;
+
+        float zMin = depth - r;
+        float zMax = depth + r;
+        if (zMax < near || zMin > far) continue;
+
+        float dMin = std::max(zMin, near);
+        float dMax = std::min(zMax, far);
+
+        // Étendue NDC de la sphère sur [dMin, dMax] : extrêmes aux coins (x/d monotone)
+        auto ndcRange = [&](float center, float tanHalf, float& outMin, float& outMax) {
+            float a = (center - r) / (dMin * tanHalf);
+            float b = (center - r) / (dMax * tanHalf);
+            float c = (center + r) / (dMin * tanHalf);
+            float d = (center + r) / (dMax * tanHalf);
+            outMin = std::min(std::min(a, b), std::min(c, d));
+            outMax = std::max(std::max(a, b), std::max(c, d));
+        };
+
+        float nxMin, nxMax, nyMin, nyMax;
+        ndcRange(p.x, tanX, nxMin, nxMax);
+        ndcRange(p.y, tanY, nyMin, nyMax);
+        if (nxMax < -1.0f || nxMin > 1.0f || nyMax < -1.0f || nyMin > 1.0f) continue;
+
+        auto toTile = [](float ndc, int count) {
+            int tile = static_cast<int>(std::floor((ndc + 1.0f) * 0.5f * count));
+            return std::min(std::max(tile, 0), count - 1);
+        };
+
+        int x0 = toTile(nxMin, GRID_X), x1 = toTile(nxMax, GRID_X);
+        int y0 = toTile(nyMin, GRID_Y), y1 = toTile(nyMax, GRID_Y);
+        int z0 = sliceForDepth(dMin), z1 = sliceForDepth(dMax);
+
+        for (int z = z0; z <= z1; ++z) {
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    int c = x + GRID_X * (y + GRID_Y * z);
+
+                    // Sphère vs AABB du cluster
+                    glm::vec3 closest = glm::clamp(p, m_clusterMin[c], m_clusterMax[c]);
+                    glm::vec3 delta = closest - p;
+                    if (glm::dot(delta, delta) > r * r) continue;
+
+                    m_pairCluster.push_back(static_cast<GLuint>(c));
+                    m_pairLight.push_back(static_cast<GLuint>(i));
+                }
+            }
+        }
+    }
+
+    // Tri par comptage : (offset, count) par cluster puis liste compacte d'indices
+    std::fill(m_clusterData.begin(), m_clusterData.end(), 0u);
+    for (GLuint c : m_pairCluster) {
+        ++m_clusterData[c * 2 + 1];
+    }
+
+    GLuint offset = 0;
+    m_maxPerCluster = 0;
+    m_activeClusters = 0;
+    for (int c = 0; c < CLUSTER_COUNT; ++c) {
+        GLuint count = m_clusterData[c * 2 + 1];
+        m_clusterData[c * 2 + 0] = offset;
+        offset += count;
+        if (count > 0) ++m_activeClusters;
+        m_maxPerCluster = std::max(m_maxPerCluster, static_cast<int>(count));
+    }
+
+    m_indices.resize(m_pairCluster.size());
+    for (int c = 0; c < CLUSTER_COUNT; ++c) {
+        m_cursor[c] = m_clusterData[c * 2 + 0];
+    }
+    for (size_t k = 0; k < m_pairCluster.size(); ++k) {
+        m_indices[m_cursor[m_pairCluster[k]]++] = m_pairLight[k];
+    }
+
+    upload(m_lights, m_lightData.data(), m_lightData.size() * sizeof(glm::vec4));
+    upload(m_clusters, m_clusterData.data(), m_clusterData.size() * sizeof(GLuint));
+    upload(m_lightIndices, m_indices.data(), m_indices.size() * sizeof(GLuint));
+}
+
+void LightClusterer::bind(Shader& shader, int screenWidth, int screenHeight) const {
+    glActiveTexture(GL_TEXTURE0 + LIGHT_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, m_lights.texture);
+    glActiveTexture(GL_TEXTURE0 + CLUSTER_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, m_clusters.texture);
+    glActiveTexture(GL_TEXTURE0 + INDEX_UNIT);
+    glBindTexture(GL_TEXTURE_BUFFER, m_lightIndices.texture);
+    glActiveTexture(GL_TEXTURE0);
+
+    shader.setInt("clusterLights", LIGHT_UNIT);
+    shader.setInt("clusterRanges", CLUSTER_UNIT);
+    shader.setInt("clusterIndices", INDEX_UNIT);
+
+    // tuile = gl_FragCoord.xy * tileScale ; tranche = log(profondeur) * x + y
+    shader.setVec2("clusterTileScale", glm::vec2(static_cast<float>(GRID_X) / std::max(screenWidth, 1),
+                                                 static_cast<float>(GRID_Y) / std::max(screenHeight, 1)));
+    float logRatio = std::log(m_far / m_near);
+    shader.setVec2("clusterDepthParams", glm::vec2(GRID_Z / logRatio,
+                                                   -GRID_Z * std::log(m_near) / logRatio));
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+class Shader;
+
+/**
+ * @class LightClusterer
+ * @brief Éclairage "clustered forward" : nombre de lumières non borné
+ *
+ * - Frustum découpé en GRID_X x GRID_Y tuiles écran x GRID_Z tranches de
+ *   profondeur exponentielles (vue)
+ * - Assignation CPU chaque frame : sphère d'influence de chaque lumière
+ *   testée contre l'AABB (espace vue) des clusters qu'elle peut toucher
+ * - Résultat envoyé au GPU dans trois texture buffers (compatibles GL 3.3) :
+ *   lumières, (offset, count) par cluster, liste d'indices de lumières
+ *
+ * Le fragment shader ne parcourt que les lumières de son cluster :
+ * coût par fragment constant quel que soit le nombre total de lumières.
+ */
+class LightClusterer {
+public:
+    struct PointLight {
+        glm::vec3 position;           // monde
+        glm::vec3 color;
+        float intensity = 1.0f;
+        float radius = 50.0f;         // influence nulle au-delà (fenêtre lissée)
+    };
+
+    static constexpr int GRID_X = 16;
+    static constexpr int GRID_Y = 9;
+    static constexpr int GRID_Z = 24;
+    static constexpr int CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+
+    // Unités de texture réservées aux buffers (l'unité 0 reste aux textures diffuses)
+    static constexpr int LIGHT_UNIT   = 5;
+    static constexpr int CLUSTER_UNIT = 6;
+    static constexpr int INDEX_UNIT   = 7;
+
+    LightClusterer();
+    ~LightClusterer();
+
+    // Non-copiable (ressources GPU)
+    LightClusterer(const LightClusterer&) = delete;
+    LightClusterer& operator=(const LightClusterer&) = delete;
+
+    /**
+     * @brief Assigne les lumières aux clusters et met à jour les buffers GPU
+     * Les AABB des clusters ne sont recalculées que si la projection change.
+     */
+    void update(const std::vector<PointLight>& lights, const glm::mat4& view,
+                float fovYDegrees, float aspect, float near, float far);
+
+    /**
+     * @brief Lie les texture buffers et règle les uniformes "cluster*" du shader actif
+     * @param screenWidth Largeur du framebuffer (pixels)
+     * @param screenHeight Hauteur du framebuffer (pixels)
+     */
+    void bind(Shader& shader, int screenWidth, int screenHeight) const;
+
+    size_t getLightCount() const { return m_lightCount; }
+    size_t getIndexCount() const { return m_indices.size(); }
+    int getMaxLightsPerCluster() const { return m_maxPerCluster; }
+    int getActiveClusterCount() const { return m_activeClusters; }
+
+private:
+    struct BufferTexture {
+        GLuint buffer = 0;
+        GLuint texture = 0;
+        GLenum format = 0;
+        size_t capacity = 0;    // octets alloués
+    };
+
+    static void createBufferTexture(BufferTexture& target, GLenum format);
+    static void destroyBufferTexture(BufferTexture& target);
+    static void upload(BufferTexture& target, const void* data, size_t size);
+
+    void rebuildClusterBounds(float fovYDegrees, float aspect, float near, float far);
+
+    int sliceForDepth(float depth) const;
+
+    // AABB espace vue de chaque cluster (index = x + GRID_X * (y + GRID_Y * z))
+    std::vector<glm::vec3> m_clusterMin;
+    std::vector<glm::vec3> m_clusterMax;
+
+    // Paramètres de projection ayant servi à construire les AABB
+    float m_fovY;
+    float m_aspect;
+    float m_near;
+    float m_far;
+
+    // Données CPU réutilisées d'une frame à l'autre
+    std::vector<glm::vec4> m_lightData;      // 2 texels par lumière
+    std::vector<GLuint> m_clusterData;       // (offset, count) par cluster
+    std::vector<GLuint> m_indices;
+    std::vector<GLuint> m_cursor;            // position d'écriture par cluster
+    std::vector<GLuint> m_pairCluster;       // paires (cluster, lumière) avant tri
+    std::vector<GLuint> m_pairLight;
+
+    BufferTexture m_lights;
+    BufferTexture m_clusters;
+    BufferTexture m_lightIndices;
+
+    size_t m_lightCount;
+    int m_maxPerCluster;
+    int m_activeClusters;
+};
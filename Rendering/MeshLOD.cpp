@@ -0,0 +1,56 @@
+#include "MeshLOD.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+void MeshLOD::addLevel(std::shared_ptr<Mesh> mesh, float minScreenSize) {
+    if (!mesh) {
+        throw std::runtime_error("MeshLOD: null mesh level");
+    }
+
+    Level level;
+    level.triangleCount = mesh->getIndices().size() / 3;
+    level.mesh = std::move(mesh);
+    level.minScreenSize = minScreenSize;
+    m_levels.push_back(std::move(level));
+}
+
+std::shared_ptr<MeshLOD> MeshLOD::createSphere(float radius,
+                                               const std::vector<int>& segments,
+                                               const std::vector<float>& minScreenSizes) {
+    if (segments.empty() || segments.size() != minScreenSizes.size()) {
+        throw std::runtime_error("MeshLOD: segments and thresholds must match");
+    }
+
+    auto lod = std::make_shared<MeshLOD>();
+    for (size_t i = 0; i < segments.size(); ++i) {
+        lod->addLevel(std::shared_ptr<Mesh>(new Mesh(Mesh::createSphere(radius, segments[i]))),
+                      minScreenSizes[i]);
+    }
+    return lod;
+}
+
+int MeshLOD::selectLevel(float screenSize, int currentLevel) const {
+    if (m_levels.empty()) return 0;
+
+    const int last = static_cast<int>(m_levels.size()) - 1;
+    int level = std::min(std::max(currentLevel, 0), last);
+
+    // Plus grossier : passer sous le seuil du niveau courant, avec marge
+    while (level < last && screenSize < m_levels[level].minScreenSize * (1.0f - HYSTERESIS)) {
+        ++level;
+    }
+    // Plus fin : dépasser le seuil du niveau visé, avec marge
+    while (level > 0 && screenSize >= m_levels[level - 1].minScreenSize * (1.0f + HYSTERESIS)) {
+        --level;
+    }
+    return level;
+}
+
+float MeshLOD::projectedSize(float radius, float distance, float fovYDegrees, float viewportHeight) {
+    float tanHalf = std::tan(glm::radians(fovYDegrees) * 0.5f);
+    if (distance <= radius || tanHalf <= 0.0f) {
+        return viewportHeight;  // caméra dans (ou contre) l'objet : détail maximal
+    }
+    return radius * viewportHeight / (distance * tanHalf);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "core/Mesh.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @class MeshLOD
+ * @brief Chaîne de niveaux de détail pour un mesh procédural
+ *
+ * - Niveaux triés du plus fin (0) au plus grossier
+ * - Sélection selon la taille projetée à l'écran (diamètre en pixels)
+ * - Hystérésis autour de chaque seuil pour éviter le "popping" quand
+ *   la caméra oscille autour d'une distance limite
+ *
+ * Les meshes des niveaux sont partagés entre tous les objets de la chaîne.
+ */
+class MeshLOD {
+public:
+    struct Level {
+        std::shared_ptr<Mesh> mesh;
+        float minScreenSize;      // diamètre projeté minimal (pixels) pour ce niveau
+        size_t triangleCount;
+    };
+
+    // Marge relative autour de chaque seuil (15 %)
+    static constexpr float HYSTERESIS = 0.15f;
+
+    /**
+     * @brief Ajoute un niveau (du plus fin au plus grossier)
+     * @param minScreenSize Ignoré pour le dernier niveau (toujours accepté)
+     */
+    void addLevel(std::shared_ptr<Mesh> mesh, float minScreenSize);
+
+    /**
+     * @brief Sphère UV avec un nombre de segments décroissant par niveau
+     * @param segments Segments par niveau (ex: {16, 10, 6, 4})
+     * @param minScreenSizes Seuil en pixels de chaque niveau (même taille que segments)
+     */
+    static std::shared_ptr<MeshLOD> createSphere(float radius,
+                                                 const std::vector<int>& segments,
+                                                 const std::vector<float>& minScreenSizes);
+
+    /**
+     * @brief Choisit le niveau pour une taille à l'écran, à partir du niveau courant
+     * Un niveau plus fin n'est pris qu'au-dessus de seuil * (1 + HYSTERESIS),
+     * un niveau plus grossier qu'en dessous de seuil * (1 - HYSTERESIS).
+     */
+    int selectLevel(float screenSize, int currentLevel) const;
+
+    /**
+     * @brief Diamètre projeté (pixels) d'une sphère englobante
+     * @param fovYDegrees Champ vertical de la caméra
+     * @param viewportHeight Hauteur du framebuffer (pixels)
+     */
+    static float projectedSize(float radius, float distance, float fovYDegrees, float viewportHeight);
+
+    size_t getLevelCount() const { return m_levels.size(); }
+    const Level& getLevel(int index) const { return m_levels[index]; }
+
+private:
+    std::vector<Level> m_levels;
+};
@@ -0,0 +1,42 @@
+#include "RedrawScheduler.h"
+
+void RedrawScheduler::setOnDemand(bool enabled) {
+    m_onDemand = enabled;
+    // Repartir d'une image à jour
+    m_pending |= HUD;
+}
+
+bool RedrawScheduler::beginFrame() {
+    if (!m_onDemand) {
+        m_lastReasons = m_pending;
+        m_pending = 0;
+        ++m_framesRendered;
+        return true;
+    }
+
+    if (m_pending != 0) {
+        m_lastReasons = m_pending;
+        m_pending = 0;
+        m_settleFrames = SETTLE_FRAMES;
+    } else if (m_settleFrames > 0) {
+        --m_settleFrames;
+    } else {
+        ++m_framesSkipped;
+        return false;
+    }
+
+    ++m_framesRendered;
+    return true;
+}
+
+std::string RedrawScheduler::describe(uint32_t reasons) {
+    static const char* names[] = { "input", "camera", "game", "animation", "theme", "hud", "resources", "capture" };
+
+    std::string result;
+    for (int bit = 0; bit < static_cast<int>(sizeof(names) / sizeof(names[0])); ++bit) {
+        if (!(reasons & (1u << bit))) continue;
+        if (!result.empty()) result += ", ";
+        result += names[bit];
+    }
+    return result.empty() ? "settle" : result;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @class RedrawScheduler
+ * @brief Rendu à la demande : drapeaux "sale" par sous-système, la boucle
+ * principale ne dessine (et n'échange les buffers) que s'il y a un changement
+ *
+ * - Chaque sous-système signale ce qu'il a modifié (invalidate)
+ * - Les sources continues (animation, déplacement clavier, envoi de textures,
+ *   enregistrement) ré-invalident à chaque frame tant qu'elles sont actives
+ * - Après un changement, quelques frames de stabilisation (ImGui a besoin
+ *   d'une frame après une entrée pour mettre à jour survol et layout)
+ * - Sans changement : la boucle attend les événements (glfwWaitEventsTimeout)
+ *
+ * Désactivé (mode continu), beginFrame() accepte toutes les frames.
+ */
+class RedrawScheduler {
+public:
+    enum Reason : uint32_t {
+        INPUT     = 1u << 0,    // événement fenêtre : souris, clavier, redimensionnement
+        CAMERA    = 1u << 1,
+        GAME      = 1u << 2,    // coup joué, reset
+        ANIMATION = 1u << 3,
+        THEME     = 1u << 4,
+        HUD       = 1u << 5,    // options d'affichage / fenêtres ImGui
+        RESOURCES = 1u << 6,    // textures en cours de chargement
+        CAPTURE   = 1u << 7     // enregistrement ou lectures PBO en attente
+    };
+
+    static constexpr int SETTLE_FRAMES = 2;
+    static constexpr double IDLE_TIMEOUT = 0.25;   // s, réveil pour les sources asynchrones
+
+    void setOnDemand(bool enabled);
+    bool isOnDemand() const { return m_onDemand; }
+
+    /**
+     * @brief Marque un ou plusieurs sous-systèmes comme modifiés
+     */
+    void invalidate(uint32_t reasons) { m_pending |= reasons; }
+
+    /**
+     * @brief Vrai si la prochaine itération doit dessiner (pas d'attente d'événements)
+     */
+    bool hasPendingWork() const { return !m_onDemand || m_pending != 0 || m_settleFrames > 0; }
+
+    /**
+     * @brief Décide si cette itération dessine, et consomme les drapeaux
+     * @return false : rien n'a changé, sauter rendu et swap
+     */
+    bool beginFrame();
+
+    uint32_t getLastReasons() const { return m_lastReasons; }
+    uint64_t getFramesRendered() const { return m_framesRendered; }
+    uint64_t getFramesSkipped() const { return m_framesSkipped; }
+
+    /**
+     * @brief Noms des raisons (ex: "camera, animation") pour le HUD
+     */
+    static std::string describe(uint32_t reasons);
+
+private:
+    bool m_onDemand = false;
+    uint32_t m_pending = 0;
+    uint32_t m_lastReasons = 0;
+    int m_settleFrames = 0;
+    uint64_t m_framesRendered = 0;
+    uint64_t m_framesSkipped = 0;
+};
@@ -65,6 +65,14 @@ public:
         return m_currentMode == Mode::WIREFRAME || m_currentMode == Mode::SHADED_WIRE;
     }
 
+    /**
+     * @brief Arêtes superposées aux surfaces (SHADED_WIRE) : variante USE_WIREFRAME,
+     * dessinée en une seule passe sans changer glPolygonMode
+     */
+    bool shouldDrawWireframeOverlay() const {
+        return m_currentMode == Mode::SHADED_WIRE;
+    }
+
     /**
      * @brief Configure OpenGL pour le mode actuel
      */
@@ -82,55 +90,14 @@ public:
                 break;
 
             case Mode::SHADED_WIRE:
-                // Sera rendu en deux passes dans le code principal
+                // Arêtes calculées dans le fragment shader (wireframe.gs), une seule passe
                 glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
                 glEnable(GL_CULL_FACE);
                 break;
         }
     }
 
-    /**
-     * @brief Pour le mode SHADED_WIRE, active le wireframe overlay
-     */
-    void enableWireframeOverlay() {
-        if (m_currentMode == Mode::SHADED_WIRE) {
-            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-            glDisable(GL_CULL_FACE);
-            glEnable(GL_POLYGON_OFFSET_LINE);
-            glPolygonOffset(-1.0f, -1.0f);
-        }
-    }
-
-    /**
-     * @brief Désactive le wireframe overlay
-     */
-    void disableWireframeOverlay() {
-        if (m_currentMode == Mode::SHADED_WIRE) {
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-            glEnable(GL_CULL_FACE);
-            glDisable(GL_POLYGON_OFFSET_LINE);
-        }
-    }
-
 private:
     RenderModeManager() : m_currentMode(Mode::TEXTURED) {}
     Mode m_currentMode;
 };
-
-/**
- * @brief Helper pour dessiner en mode SHADED_WIRE
- * Exemple d'utilisation dans main loop:
- * 
- * if (renderMode == Mode::SHADED_WIRE) {
- *     // Pass 1: Rendu normal avec textures
- *     renderScene(shader, objects);
- *     
- *     // Pass 2: Wireframe overlay
- *     RenderModeManager::getInstance().enableWireframeOverlay();
- *     shader.setVec3("wireframeColor", glm::vec3(0.0f, 0.0f, 0.0f));
- *     renderScene(shader, objects);
- *     RenderModeManager::getInstance().disableWireframeOverlay();
- * } else {
- *     renderScene(shader, objects);
- * }
- */
\ No newline at end of file
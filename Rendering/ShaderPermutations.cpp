@@ -0,0 +1,89 @@
+#include "ShaderPermutations.h"
+#include <stdexcept>
+#include <utility>
+
+ShaderPermutations::ShaderPermutations(Shader::ProgramSource base)
+    : m_base(std::move(base)) {
+}
+
+std::string ShaderPermutations::getFeatureDefines(uint32_t features) {
+    std::string defines;
+    if (features & TEXTURED) defines += "#define USE_TEXTURE\n";
+    if (features & LIGHTING) defines += "#define USE_LIGHTING\n";
+    if (features & WIREFRAME) defines += "#define USE_WIREFRAME\n";
+    return defines;
+}
+
+std::string ShaderPermutations::injectDefines(const std::string& source, const std::string& defines) {
+    if (defines.empty()) return source;
+
+    size_t version = source.find("#version");
+    if (version == std::string::npos) {
+        return defines + source;
+    }
+    size_t lineEnd = source.find('\n', version);
+    if (lineEnd == std::string::npos) {
+        return source + "\n" + defines;
+    }
+    std::string result = source;
+    result.insert(lineEnd + 1, defines);
+    return result;
+}
+
+Shader::ProgramSource ShaderPermutations::getSource(uint32_t features) const {
+    const std::string defines = getFeatureDefines(features);
+
+    Shader::ProgramSource source;
+    source.vertex = injectDefines(m_base.vertex, defines);
+    source.fragment = injectDefines(m_base.fragment, defines);
+    if (features & WIREFRAME) {
+        source.geometry = injectDefines(m_base.geometry, defines);
+    }
+
+    source.label = m_base.label + "[";
+    if (features & TEXTURED) source.label += "T";
+    if (features & LIGHTING) source.label += "L";
+    if (features & WIREFRAME) source.label += "W";
+    source.label += "]";
+    return source;
+}
+
+void ShaderPermutations::adopt(uint32_t features, std::unique_ptr<Shader> program) {
+    // Une variante n'utilise qu'une partie des uniformes communs : leur absence est normale
+    program->setMissingUniformWarnings(false);
+    m_variants[features] = std::move(program);
+}
+
+bool ShaderPermutations::supports(uint32_t features) const {
+    return features < VARIANT_COUNT && (!(features & WIREFRAME) || !m_base.geometry.empty());
+}
+
+Shader& ShaderPermutations::get(uint32_t features) {
+    if (!supports(features)) {
+        throw std::runtime_error("ShaderPermutations: unsupported feature mask for " + m_base.label);
+    }
+    if (!m_variants[features]) {
+        adopt(features, std::make_unique<Shader>(getSource(features)));
+    }
+    return *m_variants[features];
+}
+
+void ShaderPermutations::precompile(const std::vector<ShaderPermutations*>& sets) {
+    std::vector<Shader::ProgramSource> sources;
+    std::vector<std::pair<ShaderPermutations*, uint32_t>> targets;
+
+    for (ShaderPermutations* set : sets) {
+        if (!set) continue;
+        for (uint32_t features = 0; features < VARIANT_COUNT; ++features) {
+            if (set->m_variants[features] || !set->supports(features)) continue;
+            sources.push_back(set->getSource(features));
+            targets.emplace_back(set, features);
+        }
+    }
+    if (sources.empty()) return;
+
+    std::vector<std::unique_ptr<Shader>> programs = Shader::createPrograms(sources);
+    for (size_t i = 0; i < programs.size(); ++i) {
+        targets[i].first->adopt(targets[i].second, std::move(programs[i]));
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "shader.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class ShaderPermutations
+ * @brief Variantes d'un même programme compilées par #define au lieu de
+ * branches sur uniformes (useTextures / hasTexture / lightingEnabled)
+ *
+ * - Une variante par combinaison de Feature (index = masque de bits)
+ * - Les #define sont insérés juste après la ligne #version de chaque étage
+ * - L'étage géométrie de la base (wireframe.gs) n'est lié qu'aux variantes WIREFRAME
+ * - Variantes créées à la demande, ou toutes d'un coup via precompile()
+ *   (compilation parallèle + cache de binaires de Shader)
+ * - Le fragment shader n'exécute que le code de sa variante : plus de
+ *   branche par pixel, les uniformes inutilisés disparaissent du programme
+ */
+class ShaderPermutations {
+public:
+    enum Feature : uint32_t {
+        TEXTURED = 1u << 0,     // USE_TEXTURE : couleur de base lue dans diffuseTextures
+        LIGHTING = 1u << 1,     // USE_LIGHTING : Blinn-Phong sur les lumières du cluster
+        WIREFRAME = 1u << 2     // USE_WIREFRAME : arêtes en surimpression, une seule passe
+    };
+
+    static constexpr uint32_t FEATURE_COUNT = 3;
+    static constexpr uint32_t VARIANT_COUNT = 1u << FEATURE_COUNT;
+
+    explicit ShaderPermutations(Shader::ProgramSource base);
+
+    // Non-copiable (possède les programmes)
+    ShaderPermutations(const ShaderPermutations&) = delete;
+    ShaderPermutations& operator=(const ShaderPermutations&) = delete;
+
+    /**
+     * @brief Programme de la combinaison demandée (compilé au premier appel si besoin)
+     */
+    Shader& get(uint32_t features);
+
+    /**
+     * @brief Compile en un seul lot toutes les variantes manquantes des ensembles donnés
+     */
+    static void precompile(const std::vector<ShaderPermutations*>& sets);
+
+    /**
+     * @brief Sources de la variante : base + #define des features actives
+     */
+    Shader::ProgramSource getSource(uint32_t features) const;
+
+    static std::string getFeatureDefines(uint32_t features);
+
+    /**
+     * @brief Insère les #define après la directive #version (obligatoirement en tête)
+     */
+    static std::string injectDefines(const std::string& source, const std::string& defines);
+
+    /**
+     * @brief Faux pour les variantes WIREFRAME si la base n'a pas d'étage géométrie
+     */
+    bool supports(uint32_t features) const;
+
+private:
+    void adopt(uint32_t features, std::unique_ptr<Shader> program);
+
+    Shader::ProgramSource m_base;
+    std::unique_ptr<Shader> m_variants[VARIANT_COUNT];
+};
@@ -0,0 +1,396 @@
+#include "TextureCache.h"
+#include "core/MappedFile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+// Absents de certains profils GLAD générés sans les extensions S3TC
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+uint64_t TextureCache::Image::getByteSize() const {
+    uint64_t total = 0;
+    for (const Level& level : levels) total += level.size;
+    return total;
+}
+
+// ===== DESCRIPTION GL =====
+
+GLenum TextureCache::getInternalFormat(Format format, bool srgb) {
+    switch (format) {
+        case Format::R8:    return GL_RED;
+        case Format::RGB8:  return srgb ? GL_SRGB : GL_RGB;
+        case Format::RGBA8: return srgb ? GL_SRGB_ALPHA : GL_RGBA;
+        case Format::BC1:   return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case Format::BC3:   return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    }
+    return GL_RGBA;
+}
+
+GLenum TextureCache::getDataFormat(Format format) {
+    switch (format) {
+        case Format::R8:   return GL_RED;
+        case Format::RGB8: return GL_RGB;
+        default:           return GL_RGBA;
+    }
+}
+
+int TextureCache::getChannelCount(Format format) {
+    switch (format) {
+        case Format::R8:   return 1;
+        case Format::RGB8: return 3;
+        default:           return 4;
+    }
+}
+
+// ===== MIPMAPS =====
+
+namespace {
+
+struct SrgbTables {
+    float toLinear[256];
+    SrgbTables() {
+        for (int i = 0; i < 256; ++i) {
+            float c = i / 255.0f;
+            toLinear[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+    }
+};
+
+unsigned char linearToSrgb(float c) {
+    c = std::min(std::max(c, 0.0f), 1.0f);
+    float s = (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+    return static_cast<unsigned char>(std::lround(s * 255.0f));
+}
+
+// Réduction 2x2 (boîte) ; les canaux couleur des textures sRGB sont moyennés en linéaire
+std::vector<unsigned char> downsample(const std::vector<unsigned char>& src, int width, int height,
+                                      int channels, bool srgb, int& outWidth, int& outHeight) {
+    static const SrgbTables tables;
+
+    outWidth = std::max(1, width / 2);
+    outHeight = std::max(1, height / 2);
+    std::vector<unsigned char> dst(static_cast<size_t>(outWidth) * outHeight * channels);
+
+    const int colorChannels = (channels >= 3) ? 3 : channels;
+
+    for (int y = 0; y < outHeight; ++y) {
+        const int y0 = std::min(y * 2, height - 1);
+        const int y1 = std::min(y * 2 + 1, height - 1);
+        for (int x = 0; x < outWidth; ++x) {
+            const int x0 = std::min(x * 2, width - 1);
+            const int x1 = std::min(x * 2 + 1, width - 1);
+            const unsigned char* p[4] = {
+                &src[(static_cast<size_t>(y0) * width + x0) * channels],
+                &src[(static_cast<size_t>(y0) * width + x1) * channels],
+                &src[(static_cast<size_t>(y1) * width + x0) * channels],
+                &src[(static_cast<size_t>(y1) * width + x1) * channels]
+            };
+            unsigned char* out = &dst[(static_cast<size_t>(y) * outWidth + x) * channels];
+
+            for (int c = 0; c < channels; ++c) {
+                if (srgb && c < colorChannels && channels >= 3) {
+                    float sum = tables.toLinear[p[0][c]] + tables.toLinear[p[1][c]] +
+                                tables.toLinear[p[2][c]] + tables.toLinear[p[3][c]];
+                    out[c] = linearToSrgb(sum * 0.25f);
+                } else {
+                    out[c] = static_cast<unsigned char>((p[0][c] + p[1][c] + p[2][c] + p[3][c] + 2) / 4);
+                }
+            }
+        }
+    }
+    return dst;
+}
+
+// ===== COMPRESSION BC1 / BC3 =====
+
+uint16_t toRgb565(const unsigned char* c) {
+    return static_cast<uint16_t>(((c[0] >> 3) << 11) | ((c[1] >> 2) << 5) | (c[2] >> 3));
+}
+
+void fromRgb565(uint16_t v, int* out) {
+    int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+// Bloc couleur : extrémités = boîte englobante légèrement rentrée, index au plus proche
+void encodeColorBlock(const unsigned char block[16][4], unsigned char* out) {
+    unsigned char minC[3] = { 255, 255, 255 }, maxC[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            minC[c] = std::min(minC[c], block[i][c]);
+            maxC[c] = std::max(maxC[c], block[i][c]);
+        }
+    }
+    for (int c = 0; c < 3; ++c) {
+        int inset = (maxC[c] - minC[c]) >> 4;
+        minC[c] = static_cast<unsigned char>(std::min(255, minC[c] + inset));
+        maxC[c] = static_cast<unsigned char>(std::max(0, maxC[c] - inset));
+    }
+
+    uint16_t c0 = toRgb565(maxC);
+    uint16_t c1 = toRgb565(minC);
+    uint32_t indices = 0;
+
+    if (c0 != c1) {
+        // Mode 4 couleurs : exige c0 > c1
+        if (c0 < c1) std::swap(c0, c1);
+
+        int palette[4][3];
+        fromRgb565(c0, palette[0]);
+        fromRgb565(c1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestDist = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                int dr = block[i][0] - palette[p][0];
+                int dg = block[i][1] - palette[p][1];
+                int db = block[i][2] - palette[p][2];
+                int dist = dr * dr + dg * dg + db * db;
+                if (dist < bestDist) {
+                    bestDist = dist;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint32_t>(best) << (2 * i);
+        }
+    }
+
+    out[0] = static_cast<unsigned char>(c0 & 0xFF);
+    out[1] = static_cast<unsigned char>(c0 >> 8);
+    out[2] = static_cast<unsigned char>(c1 & 0xFF);
+    out[3] = static_cast<unsigned char>(c1 >> 8);
+    std::memcpy(out + 4, &indices, 4);  // petit-boutiste (x86/ARM)
+}
+
+// Bloc alpha BC3 : mode 8 valeurs (a0 > a1), index 3 bits
+void encodeAlphaBlock(const unsigned char block[16][4], unsigned char* out) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        a0 = std::max(a0, static_cast<int>(block[i][3]));
+        a1 = std::min(a1, static_cast<int>(block[i][3]));
+    }
+
+    uint64_t bits = 0;
+    if (a0 != a1) {
+        int palette[8] = { a0, a1 };
+        for (int p = 1; p < 7; ++p) palette[p + 1] = ((7 - p) * a0 + p * a1) / 7;
+
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestDist = 256;
+            for (int p = 0; p < 8; ++p) {
+                int dist = std::abs(block[i][3] - palette[p]);
+                if (dist < bestDist) {
+                    bestDist = dist;
+                    best = p;
+                }
+            }
+            bits |= static_cast<uint64_t>(best) << (3 * i);
+        }
+    }
+
+    out[0] = static_cast<unsigned char>(a0);
+    out[1] = static_cast<unsigned char>(a1);
+    for (int b = 0; b < 6; ++b) out[2 + b] = static_cast<unsigned char>(bits >> (8 * b));
+}
+
+// Compresse un niveau RGB/RGBA ; les blocs de bord répètent la dernière ligne/colonne
+std::vector<unsigned char> compressLevel(const std::vector<unsigned char>& pixels, int width, int height,
+                                         int channels, bool withAlpha) {
+    const int blocksX = (width + 3) / 4;
+    const int blocksY = (height + 3) / 4;
+    const int blockBytes = withAlpha ? 16 : 8;
+    std::vector<unsigned char> out(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+
+    unsigned char block[16][4];
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            for (int i = 0; i < 16; ++i) {
+                int x = std::min(bx * 4 + (i & 3), width - 1);
+                int y = std::min(by * 4 + (i >> 2), height - 1);
+                const unsigned char* p = &pixels[(static_cast<size_t>(y) * width + x) * channels];
+                block[i][0] = p[0];
+                block[i][1] = p[1];
+                block[i][2] = p[2];
+                block[i][3] = (channels == 4) ? p[3] : 255;
+            }
+
+            unsigned char* dst = &out[(static_cast<size_t>(by) * blocksX + bx) * blockBytes];
+            if (withAlpha) {
+                encodeAlphaBlock(block, dst);
+                encodeColorBlock(block, dst + 8);
+            } else {
+                encodeColorBlock(block, dst);
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+void TextureCache::build(const unsigned char* pixels, int width, int height, int channels,
+                         bool srgb, bool compress, Image& out) {
+    // Gris + alpha : étendu en RGBA (pas d'équivalent direct côté GL)
+    std::vector<unsigned char> level;
+    if (channels == 2) {
+        level.resize(static_cast<size_t>(width) * height * 4);
+        for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i) {
+            level[i * 4 + 0] = level[i * 4 + 1] = level[i * 4 + 2] = pixels[i * 2];
+            level[i * 4 + 3] = pixels[i * 2 + 1];
+        }
+        channels = 4;
+    } else {
+        level.assign(pixels, pixels + static_cast<size_t>(width) * height * channels);
+    }
+
+    out.srgb = srgb && channels >= 3;
+    out.format = (channels == 1) ? Format::R8 : (channels == 3) ? Format::RGB8 : Format::RGBA8;
+    if (compress && channels >= 3) {
+        out.format = (channels == 3) ? Format::BC1 : Format::BC3;
+    }
+
+    out.levels.clear();
+    out.storage.clear();
+    out.file.reset();
+
+    int w = width, h = height;
+    for (;;) {
+        Level entry;
+        entry.width = static_cast<uint32_t>(w);
+        entry.height = static_cast<uint32_t>(h);
+        entry.offset = out.storage.size();
+
+        if (isCompressed(out.format)) {
+            std::vector<unsigned char> blocks = compressLevel(level, w, h, channels, out.format == Format::BC3);
+            out.storage.insert(out.storage.end(), blocks.begin(), blocks.end());
+        } else {
+            out.storage.insert(out.storage.end(), level.begin(), level.end());
+        }
+        entry.size = out.storage.size() - entry.offset;
+        out.levels.push_back(entry);
+
+        if (w == 1 && h == 1) break;
+        int nextW, nextH;
+        level = downsample(level, w, h, channels, out.srgb, nextW, nextH);
+        w = nextW;
+        h = nextH;
+    }
+
+    out.data = out.storage.data();
+}
+
+// ===== FICHIER =====
+
+bool TextureCache::getSourceStamp(const std::string& sourcePath, uint64_t& outSize, int64_t& outTime) {
+    std::error_code ec;
+    outSize = std::filesystem::file_size(sourcePath, ec);
+    if (ec) return false;
+    auto time = std::filesystem::last_write_time(sourcePath, ec);
+    if (ec) return false;
+    outTime = static_cast<int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+bool TextureCache::read(const std::string& cachePath, const std::string& sourcePath,
+                        bool srgb, bool compress, Image& out) {
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    if (!getSourceStamp(sourcePath, sourceSize, sourceTime)) return false;
+
+    std::error_code ec;
+    if (!std::filesystem::exists(cachePath, ec)) return false;
+
+    std::shared_ptr<MappedFile> file;
+    try {
+        file = std::make_shared<MappedFile>(cachePath);
+    } catch (const std::exception&) {
+        return false;
+    }
+    if (file->size() < sizeof(CacheHeader)) return false;
+
+    CacheHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+
+    if (std::memcmp(header.magic, "MCTEX\0\0\0", 8) != 0 ||
+        header.version != CACHE_VERSION ||
+        header.format > static_cast<uint32_t>(Format::BC3) ||
+        header.sourceSize != sourceSize ||
+        header.sourceTime != sourceTime ||
+        header.levelCount == 0 || header.levelCount > 32) {
+        return false;
+    }
+
+    Format format = static_cast<Format>(header.format);
+    // Compressé alors que le GPU ne le supporte pas (ou l'inverse) : reconstruire
+    if (isCompressed(format) != (compress && getChannelCount(format) >= 3)) return false;
+    // Le mode sRGB ne concerne que les images couleur
+    if ((header.srgb != 0) != (srgb && getChannelCount(format) >= 3)) return false;
+
+    const size_t tableBytes = header.levelCount * sizeof(Level);
+    const size_t dataOffset = sizeof(CacheHeader) + tableBytes;
+    if (file->size() < dataOffset) return false;
+
+    out.levels.resize(header.levelCount);
+    std::memcpy(out.levels.data(), file->data() + sizeof(CacheHeader), tableBytes);
+
+    const uint64_t dataSize = file->size() - dataOffset;
+    for (const Level& level : out.levels) {
+        if (level.offset > dataSize || level.size > dataSize - level.offset) return false;
+    }
+
+    out.format = format;
+    out.srgb = header.srgb != 0;
+    out.storage.clear();
+    out.data = reinterpret_cast<const unsigned char*>(file->data()) + dataOffset;
+    out.file = std::move(file);
+    return true;
+}
+
+bool TextureCache::write(const std::string& cachePath, const std::string& sourcePath, const Image& image) {
+    CacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "MCTEX\0\0\0", 8);
+    header.version = CACHE_VERSION;
+    header.format = static_cast<uint32_t>(image.format);
+    header.srgb = image.srgb ? 1u : 0u;
+    header.levelCount = static_cast<uint32_t>(image.levels.size());
+    if (!getSourceStamp(sourcePath, header.sourceSize, header.sourceTime)) return false;
+
+    // Écriture dans un fichier temporaire puis renommage : jamais de cache à moitié écrit
+    std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(image.levels.data()), image.levels.size() * sizeof(Level));
+        file.write(reinterpret_cast<const char*>(image.data), static_cast<std::streamsize>(image.getByteSize()));
+        if (!file) return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <glad/gl.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class MappedFile;
+
+/**
+ * @class TextureCache
+ * @brief Conteneur de textures pré-calculé (".texcache") : toute la chaîne de
+ * mipmaps, éventuellement compressée en blocs (BC1 / BC3)
+ *
+ * - Construit au premier chargement à partir de l'image décodée (réduction
+ *   2x2 en espace linéaire pour les textures sRGB), écrit à côté du source
+ * - Relu par projection mémoire (MappedFile) : aucun décodage PNG/JPG ni
+ *   glGenerateMipmap aux démarrages suivants, les niveaux sont envoyés tels quels
+ * - Invalide si la taille/date du source, le mode sRGB ou le format demandé changent
+ */
+class TextureCache {
+public:
+    enum class Format : uint32_t {
+        R8 = 0,
+        RGB8,
+        RGBA8,
+        BC1,    // RGB, blocs 4x4 de 8 octets
+        BC3     // RGBA, blocs 4x4 de 16 octets
+    };
+
+    struct Level {
+        uint32_t width;
+        uint32_t height;
+        uint64_t offset;    // depuis le début des données de l'image
+        uint64_t size;
+    };
+
+    /**
+     * @brief Image prête à l'envoi : niveaux contigus dans storage ou dans le fichier projeté
+     */
+    struct Image {
+        Format format = Format::RGBA8;
+        bool srgb = false;
+        uint32_t layers = 1;        // > 1 : tableau, couches contiguës dans chaque niveau (non persisté)
+        std::vector<Level> levels;
+        std::vector<unsigned char> storage;
+        std::shared_ptr<MappedFile> file;
+        const unsigned char* data = nullptr;
+
+        uint32_t getWidth() const { return levels.empty() ? 0 : levels[0].width; }
+        uint32_t getHeight() const { return levels.empty() ? 0 : levels[0].height; }
+        uint64_t getByteSize() const;
+    };
+
+    /**
+     * @brief Construit la chaîne de mipmaps (et compresse si compress et 3/4 canaux)
+     */
+    static void build(const unsigned char* pixels, int width, int height, int channels,
+                      bool srgb, bool compress, Image& out);
+
+    /**
+     * @brief Projette le cache en mémoire s'il correspond au source et aux options
+     * @return false si absent, obsolète, d'un autre format ou corrompu
+     */
+    static bool read(const std::string& cachePath, const std::string& sourcePath,
+                     bool srgb, bool compress, Image& out);
+
+    /**
+     * @brief Écrit le cache (échec non bloquant : retourne false)
+     */
+    static bool write(const std::string& cachePath, const std::string& sourcePath, const Image& image);
+
+    static std::string getCachePath(const std::string& sourcePath) { return sourcePath + ".texcache"; }
+
+    // ===== DESCRIPTION GL =====
+
+    static bool isCompressed(Format format) { return format == Format::BC1 || format == Format::BC3; }
+    static GLenum getInternalFormat(Format format, bool srgb);
+    static GLenum getDataFormat(Format format);
+
+    static int getChannelCount(Format format);
+
+private:
+    struct CacheHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t format;
+        uint32_t srgb;
+        uint32_t levelCount;
+        uint64_t sourceSize;
+        int64_t sourceTime;
+    };
+
+    static constexpr uint32_t CACHE_VERSION = 1;
+
+    static bool getSourceStamp(const std::string& sourcePath, uint64_t& outSize, int64_t& outTime);
+};
@@ -1,2 +1,492 @@
 #define STB_IMAGE_IMPLEMENTATION
-#include "TextureManager.h"
\ No newline at end of file
+#include "TextureManager.h"
+#include <algorithm>
+#include <cstring>
+
+// ===== CHARGEMENT ASYNCHRONE =====
+
+TextureHandle TextureManager::loadTextureAsync(const std::string& filepath, bool srgb,
+                                               glm::vec3 placeholderColor) {
+    auto existing = m_asyncByPath.find(filepath);
+    if (existing != m_asyncByPath.end()) {
+        return existing->second;
+    }
+
+    TextureHandle handle = m_nextHandle++;
+
+    AsyncTexture& entry = m_asyncTextures[handle];
+    entry.path = filepath;
+    entry.srgb = srgb;
+
+    // Déjà chargée en synchrone : rien à décoder
+    auto cached = m_textureCache.find(filepath);
+    if (cached != m_textureCache.end()) {
+        entry.texture = cached->second;
+    } else {
+        entry.placeholder = createSolidColorTexture(placeholderColor);
+        ++m_pendingCount;
+
+        const bool compress = isCompressionSupported();
+        startWorker();
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_decodeQueue.push_back({ handle, filepath, srgb, compress });
+        }
+        m_queueCondition.notify_one();
+    }
+
+    m_asyncByPath[filepath] = handle;
+    return handle;
+}
+
+TextureHandle TextureManager::loadTextureArrayAsync(const std::vector<std::string>& layerPaths, int layerSize,
+                                                    bool srgb, const std::vector<glm::vec3>& placeholderColors) {
+    if (layerPaths.empty()) return 0;
+
+    // Clé : la liste ordonnée des couches et leur taille
+    std::string key = "array:" + std::to_string(layerSize);
+    for (const auto& path : layerPaths) key += "|" + path;
+
+    auto existing = m_asyncByPath.find(key);
+    if (existing != m_asyncByPath.end()) {
+        return existing->second;
+    }
+
+    TextureHandle handle = m_nextHandle++;
+
+    AsyncTexture& entry = m_asyncTextures[handle];
+    entry.path = key;
+    entry.srgb = srgb;
+    entry.target = GL_TEXTURE_2D_ARRAY;
+
+    std::vector<glm::vec3> colors = placeholderColors;
+    colors.resize(layerPaths.size(), glm::vec3(0.5f));
+    entry.placeholder = createSolidColorArray(colors);
+    ++m_pendingCount;
+
+    startWorker();
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_decodeQueue.push_back({ handle, key, srgb, false, layerPaths, layerSize });
+    }
+    m_queueCondition.notify_one();
+
+    m_asyncByPath[key] = handle;
+    return handle;
+}
+
+GLenum TextureManager::getTextureTarget(TextureHandle handle) const {
+    auto it = m_asyncTextures.find(handle);
+    return it != m_asyncTextures.end() ? it->second.target : GL_TEXTURE_2D;
+}
+
+GLuint TextureManager::getTextureID(TextureHandle handle) const {
+    auto it = m_asyncTextures.find(handle);
+    if (it == m_asyncTextures.end()) return 0;
+    return it->second.texture ? it->second.texture : it->second.placeholder;
+}
+
+bool TextureManager::isTextureReady(TextureHandle handle) const {
+    auto it = m_asyncTextures.find(handle);
+    return it != m_asyncTextures.end() && it->second.texture != 0;
+}
+
+void TextureManager::startWorker() {
+    if (m_worker.joinable()) return;
+    m_stopWorker = false;
+    m_worker = std::thread(&TextureManager::workerLoop, this);
+}
+
+void TextureManager::stopWorker() {
+    if (!m_worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stopWorker = true;
+        m_decodeQueue.clear();
+    }
+    m_queueCondition.notify_all();
+    m_worker.join();
+    m_decodedQueue.clear();
+}
+
+void TextureManager::workerLoop() {
+    for (;;) {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait(lock, [this] { return m_stopWorker || !m_decodeQueue.empty(); });
+            if (m_stopWorker) return;
+            job = std::move(m_decodeQueue.front());
+            m_decodeQueue.pop_front();
+        }
+
+        DecodedImage image;
+        image.handle = job.handle;
+        if (job.layers.empty()) {
+            image.ok = loadImage(job.path, job.srgb, job.compress, image.image, image.fromCache);
+        } else {
+            image.ok = loadArrayImage(job.layers, job.layerSize, job.srgb, image.image, image.fromCache);
+        }
+
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_decodedQueue.push_back(std::move(image));
+    }
+}
+
+void TextureManager::processUploads(size_t byteBudget) {
+    // Récupérer les images décodées
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        while (!m_decodedQueue.empty()) {
+            DecodedImage image = std::move(m_decodedQueue.front());
+            m_decodedQueue.pop_front();
+
+            auto it = m_asyncTextures.find(image.handle);
+            if (it == m_asyncTextures.end()) continue;  // libérée entre-temps
+
+            if (!image.ok) {
+                // Échec : le placeholder reste en place
+                std::cerr << "[TextureManager] Failed to load texture: " << it->second.path << std::endl;
+                --m_pendingCount;
+                continue;
+            }
+            it->second.image = std::move(image.image);
+            it->second.fromCache = image.fromCache;
+            m_uploadQueue.push_back(it->first);
+        }
+    }
+
+    while (!m_uploadQueue.empty() && byteBudget > 0) {
+        auto it = m_asyncTextures.find(m_uploadQueue.front());
+        if (it == m_asyncTextures.end() || uploadLevels(it->second, byteBudget)) {
+            m_uploadQueue.pop_front();
+        }
+    }
+}
+
+bool TextureManager::uploadLevels(AsyncTexture& entry, size_t& byteBudget) {
+    const TextureCache::Image& image = entry.image;
+    const TextureCache::Format format = image.format;
+    const bool compressed = TextureCache::isCompressed(format);
+    const bool isArray = entry.target == GL_TEXTURE_2D_ARRAY;
+    const GLenum internalFormat = TextureCache::getInternalFormat(format, image.srgb);
+    const GLenum dataFormat = TextureCache::getDataFormat(format);
+
+    // Texture de travail distincte : le placeholder reste affiché jusqu'à la fin
+    if (!entry.uploading) glGenTextures(1, &entry.uploading);
+    glBindTexture(entry.target, entry.uploading);
+
+    if (!m_uploadPBO) glGenBuffers(1, &m_uploadPBO);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uploadPBO);
+
+    while (entry.level < image.levels.size() && byteBudget > 0) {
+        const TextureCache::Level& level = image.levels[entry.level];
+        const GLint mip = static_cast<GLint>(entry.level);
+        const size_t layerBytes = static_cast<size_t>(level.size / image.layers);
+        const unsigned char* levelData = image.data + level.offset + layerBytes * entry.layer;
+
+        // Niveau compressé envoyé d'un bloc (déjà ~6x plus petit) ;
+        // niveau brut par bandes de lignes tenant dans le budget (au moins une)
+        size_t bytes = layerBytes;
+        uint32_t rows = level.height;
+        const size_t rowBytes = static_cast<size_t>(level.width) * TextureCache::getChannelCount(format);
+        if (!compressed) {
+            rows = static_cast<uint32_t>(std::max<size_t>(1, byteBudget / rowBytes));
+            rows = std::min(rows, level.height - entry.rowsUploaded);
+            bytes = rowBytes * rows;
+            levelData += rowBytes * entry.rowsUploaded;
+
+            if (entry.rowsUploaded == 0 && entry.layer == 0) {
+                if (isArray) {
+                    glTexImage3D(GL_TEXTURE_2D_ARRAY, mip, internalFormat, level.width, level.height,
+                                 image.layers, 0, dataFormat, GL_UNSIGNED_BYTE, nullptr);
+                } else {
+                    glTexImage2D(GL_TEXTURE_2D, mip, internalFormat, level.width, level.height, 0,
+                                 dataFormat, GL_UNSIGNED_BYTE, nullptr);
+                }
+            }
+        }
+
+        // Orphaning : le pilote peut encore lire la bande précédente
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+        void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes,
+                                        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        const void* source = nullptr;  // offset 0 dans le PBO
+        if (mapped) {
+            std::memcpy(mapped, levelData, bytes);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        } else {
+            // Mapping refusé : envoi direct depuis la mémoire client
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            source = levelData;
+        }
+
+        if (compressed) {
+            // Les tableaux sont toujours en RGBA8 : ici uniquement GL_TEXTURE_2D
+            glCompressedTexImage2D(GL_TEXTURE_2D, mip, internalFormat, level.width, level.height, 0,
+                                   static_cast<GLsizei>(bytes), source);
+        } else if (isArray) {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, mip, 0, entry.rowsUploaded, entry.layer,
+                            level.width, rows, 1, dataFormat, GL_UNSIGNED_BYTE, source);
+        } else {
+            glTexSubImage2D(GL_TEXTURE_2D, mip, 0, entry.rowsUploaded, level.width, rows,
+                            dataFormat, GL_UNSIGNED_BYTE, source);
+        }
+        if (!mapped) glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uploadPBO);
+
+        byteBudget -= std::min(bytes, byteBudget);
+        entry.rowsUploaded += rows;
+        if (compressed || entry.rowsUploaded >= level.height) {
+            entry.rowsUploaded = 0;
+            if (++entry.layer >= image.layers) {
+                entry.layer = 0;
+                ++entry.level;
+            }
+        }
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    if (entry.level < image.levels.size()) return false;
+
+    // Terminée : paramètres, puis remplacement du placeholder
+    applySamplerParameters(entry.target, image.levels.size());
+
+    entry.texture = entry.uploading;
+    entry.uploading = 0;
+    glDeleteTextures(1, &entry.placeholder);
+    entry.placeholder = 0;
+    m_textureCache[entry.path] = entry.texture;
+    --m_pendingCount;
+
+    std::cout << "[TextureManager] Loaded (async): " << entry.path
+              << " (" << image.getWidth() << "x" << image.getHeight();
+    if (isArray) std::cout << "x" << image.layers << " layers";
+    std::cout << ", " << image.levels.size() << " levels" << (entry.fromCache ? ", cache" : "") << ")" << std::endl;
+
+    entry.image = TextureCache::Image();  // libère les pixels / le mapping
+    return true;
+}
+
+// ===== CONTENEUR PRÉ-CALCULÉ =====
+
+bool TextureManager::loadImage(const std::string& filepath, bool srgb, bool compress,
+                               TextureCache::Image& out, bool& outFromCache) {
+    const std::string cachePath = TextureCache::getCachePath(filepath);
+
+    outFromCache = TextureCache::read(cachePath, filepath, srgb, compress, out);
+    if (outFromCache) return true;
+
+    // Drapeau de retournement propre au thread appelant (l'autre est global)
+    stbi_set_flip_vertically_on_load_thread(1);
+
+    int width, height, channels;
+    unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &channels, 0);
+    if (!data) return false;
+
+    TextureCache::build(data, width, height, channels, srgb, compress, out);
+    stbi_image_free(data);
+
+    if (!TextureCache::write(cachePath, filepath, out)) {
+        std::cerr << "[TextureManager] Warning: could not write cache " << cachePath << std::endl;
+    }
+    return true;
+}
+
+GLuint TextureManager::uploadImage(const TextureCache::Image& image) {
+    const GLenum internalFormat = TextureCache::getInternalFormat(image.format, image.srgb);
+    const GLenum dataFormat = TextureCache::getDataFormat(image.format);
+
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    for (size_t i = 0; i < image.levels.size(); ++i) {
+        const TextureCache::Level& level = image.levels[i];
+        if (TextureCache::isCompressed(image.format)) {
+            glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), internalFormat,
+                                   level.width, level.height, 0,
+                                   static_cast<GLsizei>(level.size), image.data + level.offset);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), internalFormat, level.width, level.height, 0,
+                         dataFormat, GL_UNSIGNED_BYTE, image.data + level.offset);
+        }
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    applySamplerParameters(GL_TEXTURE_2D, image.levels.size());
+    return textureID;
+}
+
+void TextureManager::applySamplerParameters(GLenum target, size_t levelCount) {
+    // Chaîne de mipmaps fournie par le cache : pas de glGenerateMipmap
+    glTexParameteri(target, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levelCount) - 1);
+
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Anisotropic filtering (si supporté)
+    float maxAniso = 0.0f;
+    glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAniso);
+    glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY, maxAniso);
+}
+
+// ===== TABLEAUX DE TEXTURES =====
+
+// Image RGBA8 -> size x size, bilinéaire (couleurs sRGB filtrées telles quelles)
+static std::vector<unsigned char> resampleRGBA(const unsigned char* src, int width, int height, int size) {
+    std::vector<unsigned char> dst(static_cast<size_t>(size) * size * 4);
+    for (int y = 0; y < size; ++y) {
+        float sy = std::max(0.0f, (y + 0.5f) * height / size - 0.5f);
+        int y0 = std::min(static_cast<int>(sy), height - 1);
+        int y1 = std::min(y0 + 1, height - 1);
+        float fy = sy - y0;
+        for (int x = 0; x < size; ++x) {
+            float sx = std::max(0.0f, (x + 0.5f) * width / size - 0.5f);
+            int x0 = std::min(static_cast<int>(sx), width - 1);
+            int x1 = std::min(x0 + 1, width - 1);
+            float fx = sx - x0;
+            for (int c = 0; c < 4; ++c) {
+                float top = src[(static_cast<size_t>(y0) * width + x0) * 4 + c] * (1.0f - fx) +
+                            src[(static_cast<size_t>(y0) * width + x1) * 4 + c] * fx;
+                float bottom = src[(static_cast<size_t>(y1) * width + x0) * 4 + c] * (1.0f - fx) +
+                               src[(static_cast<size_t>(y1) * width + x1) * 4 + c] * fx;
+                dst[(static_cast<size_t>(y) * size + x) * 4 + c] =
+                    static_cast<unsigned char>(top * (1.0f - fy) + bottom * fy + 0.5f);
+            }
+        }
+    }
+    return dst;
+}
+
+// Niveau brut R/RGB/RGBA -> RGBA8
+static std::vector<unsigned char> expandToRGBA(const unsigned char* src, size_t pixelCount, int channels) {
+    std::vector<unsigned char> dst(pixelCount * 4);
+    for (size_t i = 0; i < pixelCount; ++i) {
+        const unsigned char* p = src + i * channels;
+        dst[i * 4 + 0] = p[0];
+        dst[i * 4 + 1] = channels >= 3 ? p[1] : p[0];
+        dst[i * 4 + 2] = channels >= 3 ? p[2] : p[0];
+        dst[i * 4 + 3] = channels == 4 ? p[3] : 255;
+    }
+    return dst;
+}
+
+bool TextureManager::loadArrayImage(const std::vector<std::string>& layerPaths, int layerSize, bool srgb,
+                                    TextureCache::Image& out, bool& outFromCache) {
+    // Chaîne de mipmaps de chaque couche (toutes de layerSize x layerSize au niveau 0)
+    std::vector<TextureCache::Image> layers(layerPaths.size());
+    outFromCache = true;
+
+    for (size_t i = 0; i < layerPaths.size(); ++i) {
+        TextureCache::Image source;
+        bool fromCache = false;
+        if (!loadImage(layerPaths[i], srgb, false, source, fromCache)) {
+            std::cerr << "[TextureManager] Failed to load array layer: " << layerPaths[i] << std::endl;
+            return false;
+        }
+        outFromCache = outFromCache && fromCache;
+
+        const int channels = TextureCache::getChannelCount(source.format);
+
+        // Niveau déjà à la bonne taille : reprendre la fin de la chaîne sans refiltrer
+        size_t first = source.levels.size();
+        for (size_t l = 0; l < source.levels.size(); ++l) {
+            if (source.levels[l].width == static_cast<uint32_t>(layerSize) &&
+                source.levels[l].height == static_cast<uint32_t>(layerSize)) {
+                first = l;
+                break;
+            }
+        }
+
+        TextureCache::Image& layer = layers[i];
+        if (first < source.levels.size()) {
+            layer.srgb = source.srgb;
+            for (size_t l = first; l < source.levels.size(); ++l) {
+                const TextureCache::Level& level = source.levels[l];
+                std::vector<unsigned char> rgba = expandToRGBA(source.data + level.offset,
+                                                               static_cast<size_t>(level.width) * level.height,
+                                                               channels);
+                TextureCache::Level entry = { level.width, level.height, layer.storage.size(), rgba.size() };
+                layer.storage.insert(layer.storage.end(), rgba.begin(), rgba.end());
+                layer.levels.push_back(entry);
+            }
+            layer.data = layer.storage.data();
+        } else {
+            const TextureCache::Level& level = source.levels[0];
+            std::vector<unsigned char> rgba = expandToRGBA(source.data + level.offset,
+                                                           static_cast<size_t>(level.width) * level.height,
+                                                           channels);
+            std::vector<unsigned char> resized = resampleRGBA(rgba.data(), level.width, level.height, layerSize);
+            TextureCache::build(resized.data(), layerSize, layerSize, 4, srgb, false, layer);
+        }
+    }
+
+    // Entrelacement par niveau : [niveau 0 : couche 0, couche 1...][niveau 1 : ...]
+    out = TextureCache::Image();
+    out.format = TextureCache::Format::RGBA8;
+    out.srgb = srgb;
+    out.layers = static_cast<uint32_t>(layers.size());
+
+    const size_t levelCount = layers[0].levels.size();
+    for (size_t l = 0; l < levelCount; ++l) {
+        const TextureCache::Level& reference = layers[0].levels[l];
+        TextureCache::Level entry = { reference.width, reference.height, out.storage.size(), 0 };
+        for (const TextureCache::Image& layer : layers) {
+            const TextureCache::Level& level = layer.levels[l];
+            out.storage.insert(out.storage.end(), layer.data + level.offset, layer.data + level.offset + level.size);
+        }
+        entry.size = out.storage.size() - entry.offset;
+        out.levels.push_back(entry);
+    }
+    out.data = out.storage.data();
+    return true;
+}
+
+GLuint TextureManager::createSolidColorArray(const std::vector<glm::vec3>& colors) {
+    std::vector<unsigned char> data;
+    data.reserve(colors.size() * 4);
+    for (const glm::vec3& color : colors) {
+        data.push_back(static_cast<unsigned char>(color.r * 255));
+        data.push_back(static_cast<unsigned char>(color.g * 255));
+        data.push_back(static_cast<unsigned char>(color.b * 255));
+        data.push_back(255);
+    }
+
+    GLuint textureID;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, 1, 1, static_cast<GLsizei>(colors.size()), 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    return textureID;
+}
+
+bool TextureManager::isCompressionSupported() {
+    if (m_compressionSupport < 0) {
+        bool s3tc = false, srgb = false;
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; ++i) {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (!name) continue;
+            if (std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0) s3tc = true;
+            if (std::strcmp(name, "GL_EXT_texture_sRGB") == 0 ||
+                std::strcmp(name, "GL_EXT_texture_compression_s3tc_srgb") == 0) srgb = true;
+        }
+        // Les textures de thème sont sRGB : sans les formats S3TC sRGB, rester en brut
+        m_compressionSupport = (s3tc && srgb) ? 1 : 0;
+        std::cout << "[TextureManager] Block compression (BC1/BC3): "
+                  << (m_compressionSupport ? "yes" : "no") << std::endl;
+    }
+    return m_compressionSupport == 1;
+}
@@ -6,13 +6,26 @@
 #include <vector>
 #include <string>
 #include <glm/vec3.hpp>
+#include "TextureCache.h"
 
 #include <memory>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Identifiant d'une texture chargée en asynchrone (0 = aucune)
+ */
+using TextureHandle = uint32_t;
 
 /**
  * @brief Gestionnaire de textures avec cache
  * Charge et gère les textures OpenGL
- * Utilise stb_image pour le chargement
+ * Utilise stb_image pour le chargement ; le premier chargement d'une image
+ * écrit un conteneur ".texcache" (mipmaps pré-calculées, BC1/BC3 si supporté)
+ * relu ensuite par mmap, sans décodage ni glGenerateMipmap
  */
 class TextureManager {
 public:
@@ -49,8 +62,54 @@ public:
     GLuint createCheckerboardTexture(int size, glm::vec3 color1, glm::vec3 color2);
     GLuint createSolidColorTexture(glm::vec3 color);
 
+    // ===== CHARGEMENT ASYNCHRONE =====
+
+    /**
+     * @brief Lance le décodage d'une image sur le thread de chargement
+     * Retourne immédiatement ; getTextureID() renvoie un placeholder uni
+     * (placeholderColor) jusqu'à la fin de l'envoi au GPU.
+     * Un même fichier demandé deux fois renvoie le même handle.
+     */
+    TextureHandle loadTextureAsync(const std::string& filepath, bool srgb = false,
+                                   glm::vec3 placeholderColor = glm::vec3(0.5f));
+
+    /**
+     * @brief Tableau de textures (GL_TEXTURE_2D_ARRAY) chargé en asynchrone,
+     * une couche par fichier, toutes ramenées à layerSize x layerSize en RGBA8.
+     * Les mipmaps du .texcache sont reprises telles quelles quand un niveau a
+     * déjà cette taille. Placeholder : tableau 1x1 d'une couleur par couche.
+     */
+    TextureHandle loadTextureArrayAsync(const std::vector<std::string>& layerPaths, int layerSize,
+                                        bool srgb, const std::vector<glm::vec3>& placeholderColors);
+
+    /**
+     * @brief Texture à binder pour ce handle (placeholder tant que non prête, 0 si handle inconnu)
+     */
+    GLuint getTextureID(TextureHandle handle) const;
+
+    /**
+     * @brief GL_TEXTURE_2D ou GL_TEXTURE_2D_ARRAY
+     */
+    GLenum getTextureTarget(TextureHandle handle) const;
+    bool isTextureReady(TextureHandle handle) const;
+
+    /**
+     * @brief Envoie au GPU les images décodées, via PBO, dans la limite de
+     * byteBudget octets par appel (à appeler une fois par frame, thread GL).
+     * Niveau de mipmap par niveau ; un grand niveau non compressé est réparti
+     * sur plusieurs frames par bandes de lignes.
+     */
+    void processUploads(size_t byteBudget = DEFAULT_UPLOAD_BUDGET);
+
     /**
-     * @brief Libère toutes les textures
+     * @brief Textures en cours (décodage ou envoi)
+     */
+    size_t getPendingCount() const { return m_pendingCount; }
+
+    static constexpr size_t DEFAULT_UPLOAD_BUDGET = 2 * 1024 * 1024;
+
+    /**
+     * @brief Libère toutes les textures (et arrête le thread de chargement)
      */
     void cleanup();
 
@@ -68,7 +127,94 @@ private:
 
     GLuint loadTextureFromFile(const std::string& filepath, bool srgb);
 
+    /**
+     * @brief Cache .texcache si valide, sinon décodage stb_image + construction
+     * des mipmaps + écriture du cache (appelable depuis le thread de chargement)
+     */
+    static bool loadImage(const std::string& filepath, bool srgb, bool compress,
+                          TextureCache::Image& out, bool& outFromCache);
+
+    /**
+     * @brief Envoi synchrone de tous les niveaux
+     */
+    static GLuint uploadImage(const TextureCache::Image& image);
+
+    /**
+     * @brief Paramètres communs une fois tous les niveaux présents
+     */
+    static void applySamplerParameters(GLenum target, size_t levelCount);
+
+    /**
+     * @brief Couches d'un tableau : chaque image ramenée à layerSize² RGBA8,
+     * chaîne de mipmaps commune (thread de chargement)
+     */
+    static bool loadArrayImage(const std::vector<std::string>& layerPaths, int layerSize, bool srgb,
+                               TextureCache::Image& out, bool& outFromCache);
+
+    GLuint createSolidColorArray(const std::vector<glm::vec3>& colors);
+
+    /**
+     * @brief GL_EXT_texture_compression_s3tc (+ variantes sRGB), testé une fois (thread GL)
+     */
+    bool isCompressionSupported();
+
+    struct DecodeJob {
+        TextureHandle handle;
+        std::string path;
+        bool srgb;
+        bool compress;
+        std::vector<std::string> layers;  // non vide : tableau de textures
+        int layerSize = 0;
+    };
+
+    // Image prête à l'envoi, produite par le thread de chargement
+    struct DecodedImage {
+        TextureHandle handle = 0;
+        bool ok = false;
+        bool fromCache = false;
+        TextureCache::Image image;
+    };
+
+    // État d'une texture asynchrone (thread GL uniquement)
+    struct AsyncTexture {
+        std::string path;         // clé de cache (chemins joints pour un tableau)
+        bool srgb = false;
+        GLenum target = GL_TEXTURE_2D;
+        GLuint placeholder = 0;
+        GLuint texture = 0;       // 0 tant que l'envoi n'est pas terminé
+        GLuint uploading = 0;     // texture en cours de remplissage
+        TextureCache::Image image;  // niveaux en attente d'envoi
+        bool fromCache = false;
+        size_t level = 0;         // niveau en cours
+        uint32_t layer = 0;       // couche en cours (tableau)
+        uint32_t rowsUploaded = 0;  // dans la couche en cours (non compressé)
+    };
+
+    void startWorker();
+    void stopWorker();
+    void workerLoop();
+
+    // Envoie jusqu'à byteBudget octets de la texture ; true si terminée
+    bool uploadLevels(AsyncTexture& entry, size_t& byteBudget);
+
     std::unordered_map<std::string, GLuint> m_textureCache;
+
+    // Asynchrone : état côté GL
+    std::unordered_map<TextureHandle, AsyncTexture> m_asyncTextures;
+    std::unordered_map<std::string, TextureHandle> m_asyncByPath;
+    std::deque<TextureHandle> m_uploadQueue;
+    TextureHandle m_nextHandle = 1;
+    size_t m_pendingCount = 0;
+    GLuint m_uploadPBO = 0;
+    int m_compressionSupport = -1;  // -1 = pas encore testé
+
+    // Asynchrone : files partagées avec le thread de chargement
+    std::thread m_worker;
+    std::mutex m_queueMutex;
+    std::condition_variable m_queueCondition;
+    std::deque<DecodeJob> m_decodeQueue;
+    std::deque<DecodedImage> m_decodedQueue;
+    bool m_stopWorker = false;
 };
 
 // ============================================
@@ -97,51 +243,18 @@ inline GLuint TextureManager::loadTexture(const std::string& filepath, bool srgb
 }
 
 inline GLuint TextureManager::loadTextureFromFile(const std::string& filepath, bool srgb) {
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-
-    int width, height, nrChannels;
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &nrChannels, 0);
-
-    if (!data) {
+    TextureCache::Image image;
+    bool fromCache = false;
+    if (!loadImage(filepath, srgb, isCompressionSupported(), image, fromCache)) {
         std::cerr << "[TextureManager] Failed to load texture: " << filepath << std::endl;
         return 0;
     }
 
-    GLenum internalFormat = GL_RGB;
-    GLenum dataFormat = GL_RGB;
-
-    if (nrChannels == 1) {
-        internalFormat = dataFormat = GL_RED;
-    } else if (nrChannels == 3) {
-        internalFormat = srgb ? GL_SRGB : GL_RGB;
-        dataFormat = GL_RGB;
-    } else if (nrChannels == 4) {
-        internalFormat = srgb ? GL_SRGB_ALPHA : GL_RGBA;
-        dataFormat = GL_RGBA;
-    }
-
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, 
-                 dataFormat, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-
-    // Paramètres de texture
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // Anisotropic filtering (si supporté)
-    float maxAniso = 0.0f;
-    glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &maxAniso);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, maxAniso);
-
-    stbi_image_free(data);
+    GLuint textureID = uploadImage(image);
 
     std::cout << "[TextureManager] Loaded: " << filepath 
-              << " (" << width << "x" << height << ", " << nrChannels << " channels)" << std::endl;
+              << " (" << image.getWidth() << "x" << image.getHeight() << ", "
+              << image.levels.size() << " levels" << (fromCache ? ", cache" : "") << ")" << std::endl;
 
     return textureID;
 }
@@ -201,6 +314,22 @@ inline GLuint TextureManager::getTexture(const std::string& filepath) const {
 }
 
 inline void TextureManager::cleanup() {
+    stopWorker();
+
+    // Les textures terminées sont dans m_textureCache ; reste les placeholders
+    for (auto& pair : m_asyncTextures) {
+        if (pair.second.placeholder) glDeleteTextures(1, &pair.second.placeholder);
+        if (pair.second.uploading) glDeleteTextures(1, &pair.second.uploading);
+    }
+    m_asyncTextures.clear();
+    m_asyncByPath.clear();
+    m_uploadQueue.clear();
+    m_pendingCount = 0;
+    if (m_uploadPBO) {
+        glDeleteBuffers(1, &m_uploadPBO);
+        m_uploadPBO = 0;
+    }
+
     for (auto& pair : m_textureCache) {
         glDeleteTextures(1, &pair.second);
     }
@@ -208,6 +337,13 @@ inline void TextureManager::cleanup() {
 }
 
 inline void TextureManager::releaseTexture(const std::string& filepath) {
+    // Handle asynchrone terminé : il ne doit plus pointer vers la texture libérée
+    auto async = m_asyncByPath.find(filepath);
+    if (async != m_asyncByPath.end() && m_asyncTextures[async->second].texture) {
+        m_asyncTextures.erase(async->second);
+        m_asyncByPath.erase(async);
+    }
+
     auto it = m_textureCache.find(filepath);
     if (it != m_textureCache.end()) {
         glDeleteTextures(1, &it->second);
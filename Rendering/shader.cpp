@@ -1,34 +1,62 @@
 #include "Shader.h"
 #include <glm/gtc/type_ptr.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <thread>
 
-Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath) {
-    std::string vertexSource = loadShaderFile(vertexPath);
-    std::string fragmentSource = loadShaderFile(fragmentPath);
-    
-    GLuint vertexID = compileShader(vertexSource, GL_VERTEX_SHADER);
-    GLuint fragmentID = compileShader(fragmentSource, GL_FRAGMENT_SHADER);
-    
-    linkProgram(vertexID, fragmentID);
-    
-    // Nettoyage des shaders individuels (déjà linkés)
-    glDeleteShader(vertexID);
-    glDeleteShader(fragmentID);
+// Absent des profils GLAD générés sans KHR/ARB_parallel_shader_compile (même valeur)
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+int Shader::s_binaryCacheSupport = -1;
+int Shader::s_parallelCompileSupport = -1;
+
+namespace {
+
+uint64_t hashBytes(const std::string& data, uint64_t hash = 14695981039346656037ull) {
+    // FNV-1a 64 bits : suffisant pour nommer/valider un fichier de cache
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
 }
 
-Shader::Shader(const char* vertexSource, const char* fragmentSource, bool fromSource) {
-    GLuint vertexID = compileShader(vertexSource, GL_VERTEX_SHADER);
-    GLuint fragmentID = compileShader(fragmentSource, GL_FRAGMENT_SHADER);
-    
-    linkProgram(vertexID, fragmentID);
-    
-    glDeleteShader(vertexID);
-    glDeleteShader(fragmentID);
+bool hasExtension(const char* extension) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (name && std::strcmp(name, extension) == 0) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath)
+    : Shader(loadSources(vertexPath, fragmentPath)) {
+}
+
+Shader::Shader(const char* vertexSource, const char* fragmentSource, bool fromSource)
+    : Shader(ProgramSource{ vertexSource, fragmentSource, "", "inline" }) {
+}
+
+Shader::Shader(const ProgramSource& source) {
+    begin(source);
+    finish();
 }
 
 Shader::~Shader() {
+    if (m_pendingVertex) glDeleteShader(m_pendingVertex);
+    if (m_pendingFragment) glDeleteShader(m_pendingFragment);
+    if (m_pendingGeometry) glDeleteShader(m_pendingGeometry);
     glDeleteProgram(m_programID);
 }
 
@@ -43,24 +71,125 @@ std::string Shader::loadShaderFile(const std::string& path) {
     return buffer.str();
 }
 
+Shader::ProgramSource Shader::loadSources(const std::string& vertexPath, const std::string& fragmentPath,
+                                          const std::string& geometryPath) {
+    ProgramSource source;
+    source.vertex = loadShaderFile(vertexPath);
+    source.fragment = loadShaderFile(fragmentPath);
+    if (!geometryPath.empty()) {
+        source.geometry = loadShaderFile(geometryPath);
+    }
+    source.label = std::filesystem::path(vertexPath).stem().string();
+    return source;
+}
+
 GLuint Shader::compileShader(const std::string& source, GLenum type) {
     GLuint shaderID = glCreateShader(type);
     const char* src = source.c_str();
     glShaderSource(shaderID, 1, &src, nullptr);
     glCompileShader(shaderID);
     
-    checkCompileErrors(shaderID, type == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT");
-    
     return shaderID;
 }
 
-void Shader::linkProgram(GLuint vertexID, GLuint fragmentID) {
+void Shader::linkProgram(GLuint vertexID, GLuint geometryID, GLuint fragmentID) {
     m_programID = glCreateProgram();
+    if (isBinaryCacheSupported()) {
+        glProgramParameteri(m_programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glAttachShader(m_programID, vertexID);
+    if (geometryID) glAttachShader(m_programID, geometryID);
     glAttachShader(m_programID, fragmentID);
     glLinkProgram(m_programID);
-    
+}
+
+// ===== COMPILATION DIFFÉRÉE =====
+
+void Shader::begin(const ProgramSource& source) {
+    m_label = source.label;
+    m_sourceHash = hashBytes(source.fragment, hashBytes(source.geometry + '\0', hashBytes(source.vertex + '\0')));
+
+    if (isBinaryCacheSupported() && loadBinary()) {
+        m_fromCache = true;
+        return;
+    }
+
+    // Aucune requête de statut ici : avec la compilation parallèle,
+    // le pilote travaille pendant qu'on soumet les programmes suivants
+    m_pendingVertex = compileShader(source.vertex, GL_VERTEX_SHADER);
+    m_pendingFragment = compileShader(source.fragment, GL_FRAGMENT_SHADER);
+    if (!source.geometry.empty()) {
+        m_pendingGeometry = compileShader(source.geometry, GL_GEOMETRY_SHADER);
+    }
+    linkProgram(m_pendingVertex, m_pendingGeometry, m_pendingFragment);
+}
+
+bool Shader::isLinkComplete() const {
+    if (m_fromCache || !isParallelCompileSupported()) return true;
+
+    GLint complete = GL_FALSE;
+    glGetProgramiv(m_programID, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
+
+void Shader::finish() {
+    if (m_fromCache) return;
+
+    checkCompileErrors(m_pendingVertex, "VERTEX");
+    if (m_pendingGeometry) checkCompileErrors(m_pendingGeometry, "GEOMETRY");
+    checkCompileErrors(m_pendingFragment, "FRAGMENT");
     checkCompileErrors(m_programID, "PROGRAM");
+
+    // Nettoyage des shaders individuels (déjà linkés)
+    glDetachShader(m_programID, m_pendingVertex);
+    glDetachShader(m_programID, m_pendingFragment);
+    glDeleteShader(m_pendingVertex);
+    glDeleteShader(m_pendingFragment);
+    if (m_pendingGeometry) {
+        glDetachShader(m_programID, m_pendingGeometry);
+        glDeleteShader(m_pendingGeometry);
+    }
+    m_pendingVertex = 0;
+    m_pendingFragment = 0;
+    m_pendingGeometry = 0;
+
+    if (isBinaryCacheSupported() && !saveBinary()) {
+        std::cerr << "[Shader] Could not write program binary for " << m_label << std::endl;
+    }
+}
+
+std::vector<std::unique_ptr<Shader>> Shader::createPrograms(const std::vector<ProgramSource>& sources) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::unique_ptr<Shader>> programs;
+    programs.reserve(sources.size());
+    for (const auto& source : sources) {
+        programs.emplace_back(new Shader());
+        programs.back()->begin(source);
+    }
+
+    // Finaliser dans l'ordre de complétion (sans extension : dans l'ordre, en bloquant)
+    std::vector<bool> finished(programs.size(), false);
+    size_t remaining = programs.size();
+    size_t fromCache = 0;
+    while (remaining > 0) {
+        bool progressed = false;
+        for (size_t i = 0; i < programs.size(); ++i) {
+            if (finished[i] || !programs[i]->isLinkComplete()) continue;
+            programs[i]->finish();
+            if (programs[i]->m_fromCache) ++fromCache;
+            finished[i] = true;
+            progressed = true;
+            --remaining;
+        }
+        if (!progressed) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Shader] " << programs.size() << " program(s) ready in " << ms << " ms ("
+              << fromCache << " from binary cache, parallel compile: "
+              << (isParallelCompileSupported() ? "yes" : "no") << ")" << std::endl;
+    return programs;
 }
 
 void Shader::checkCompileErrors(GLuint shader, const std::string& type) {
@@ -85,6 +214,126 @@ void Shader::checkCompileErrors(GLuint shader, const std::string& type) {
     }
 }
 
+// ===== CACHE DE BINAIRES =====
+
+bool Shader::isBinaryCacheSupported() {
+    if (s_binaryCacheSupport < 0) {
+        GLint major = 0, minor = 0, formats = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        bool api = major > 4 || (major == 4 && minor >= 1) || hasExtension("GL_ARB_get_program_binary");
+        // Certains pilotes exposent l'API sans aucun format de binaire
+        if (api) glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        s_binaryCacheSupport = (api && formats > 0) ? 1 : 0;
+    }
+    return s_binaryCacheSupport == 1;
+}
+
+bool Shader::isParallelCompileSupported() {
+    if (s_parallelCompileSupport < 0) {
+        // Nombre de threads laissé au défaut du pilote (Mesa : tous les cœurs disponibles)
+        s_parallelCompileSupport = (hasExtension("GL_KHR_parallel_shader_compile") ||
+                                    hasExtension("GL_ARB_parallel_shader_compile")) ? 1 : 0;
+    }
+    return s_parallelCompileSupport == 1;
+}
+
+const std::string& Shader::getDriverString() {
+    static const std::string driver = [] {
+        std::string result;
+        for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION }) {
+            const char* value = reinterpret_cast<const char*>(glGetString(name));
+            result += value ? value : "";
+            result += '|';
+        }
+        return result;
+    }();
+    return driver;
+}
+
+std::string Shader::getCachePath() const {
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(m_sourceHash));
+    return std::string(CACHE_DIRECTORY) + "/" + name + ".progbin";
+}
+
+bool Shader::loadBinary() {
+    std::ifstream file(getCachePath(), std::ios::binary);
+    if (!file) return false;
+
+    BinaryHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file ||
+        std::memcmp(header.magic, "MCPROG\0\0", 8) != 0 ||
+        header.version != CACHE_VERSION ||
+        header.sourceHash != m_sourceHash ||
+        header.driverHash != hashBytes(getDriverString()) ||
+        header.binarySize == 0) {
+        return false;
+    }
+
+    std::vector<char> binary(header.binarySize);
+    file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+    if (!file) return false;
+
+    m_programID = glCreateProgram();
+    glProgramBinary(m_programID, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    // Le pilote peut refuser un binaire valide en apparence (mise à jour, autre GPU)
+    GLint linked = GL_FALSE;
+    glGetProgramiv(m_programID, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        std::cout << "[Shader] Cached binary rejected for " << m_label << ", recompiling" << std::endl;
+        glDeleteProgram(m_programID);
+        m_programID = 0;
+        return false;
+    }
+    return true;
+}
+
+bool Shader::saveBinary() const {
+    GLint length = 0;
+    glGetProgramiv(m_programID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return false;
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(m_programID, length, &written, &format, binary.data());
+    if (written <= 0) return false;
+
+    BinaryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "MCPROG\0\0", 8);
+    header.version = CACHE_VERSION;
+    header.binaryFormat = format;
+    header.binarySize = static_cast<uint64_t>(written);
+    header.sourceHash = m_sourceHash;
+    header.driverHash = hashBytes(getDriverString());
+
+    std::error_code ec;
+    std::filesystem::create_directories(CACHE_DIRECTORY, ec);
+    if (ec) return false;
+
+    // Écriture dans un fichier temporaire puis renommage : jamais de binaire à moitié écrit
+    std::string cachePath = getCachePath();
+    std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), written);
+        if (!file) return false;
+    }
+
+    std::filesystem::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
 void Shader::use() const {
     glUseProgram(m_programID);
 }
@@ -97,7 +346,7 @@ GLint Shader::getUniformLocation(const std::string& name) {
     }
     
     GLint location = glGetUniformLocation(m_programID, name.c_str());
-    if (location == -1) {
+    if (location == -1 && m_warnMissingUniforms) {
         std::cerr << "[Shader] Warning: Uniform '" << name << "' not found" << std::endl;
     }
     
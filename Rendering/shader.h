@@ -2,8 +2,11 @@
 
 #include <glad/gl.h>
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 /**
  * @class Shader
@@ -14,9 +17,24 @@
  * - Linkage du programme
  * - Gestion des uniformes avec cache
  * - Détection d'erreurs
+ * - Cache des binaires de programme (shadercache/<hash>.progbin) : clé = sources
+ *   + pilote (vendor, renderer, version), repli transparent sur la compilation
+ * - Compilation de plusieurs programmes en parallèle (KHR_parallel_shader_compile)
  */
 class Shader {
 public:
+    /**
+     * @brief Sources GLSL d'un programme (label : nom affiché dans les logs)
+     */
+    struct ProgramSource {
+        std::string vertex;
+        std::string fragment;
+        std::string geometry;   // optionnel (vide : pas d'étage géométrie)
+        std::string label;
+    };
+
+    static constexpr const char* CACHE_DIRECTORY = "shadercache";
+
     /**
      * @brief Constructeur - Compile et linke les shaders
      * @param vertexPath Chemin du vertex shader
@@ -29,6 +47,11 @@ public:
      */
     Shader(const char* vertexSource, const char* fragmentSource, bool fromSource);
 
+    /**
+     * @brief Constructeur - Binaire en cache ou compilation (bloquant)
+     */
+    explicit Shader(const ProgramSource& source);
+
     /**
      * @brief Destructeur - Libère le programme GPU
      */
@@ -48,6 +71,12 @@ public:
      */
     GLuint getID() const { return m_programID; }
 
+    /**
+     * @brief Active/désactive l'avertissement "uniforme introuvable"
+     * (désactivé pour les variantes de ShaderPermutations)
+     */
+    void setMissingUniformWarnings(bool enabled) { m_warnMissingUniforms = enabled; }
+
     // ===== SETTERS UNIFORMES (avec cache de locations) =====
     
     void setBool(const std::string& name, bool value);
@@ -61,19 +90,58 @@ public:
     void setMat3(const std::string& name, const glm::mat3& value);
     void setMat4(const std::string& name, const glm::mat4& value);
 
+    // ===== CRÉATION GROUPÉE =====
+
+    /**
+     * @brief Lit les fichiers d'un programme (geometryPath optionnel)
+     */
+    static ProgramSource loadSources(const std::string& vertexPath, const std::string& fragmentPath,
+                                     const std::string& geometryPath = "");
+
+    /**
+     * @brief Crée plusieurs programmes : toutes les compilations sont soumises
+     * avant la première attente, le pilote peut les mener en parallèle
+     * @return Programmes dans l'ordre des sources (exception à la première erreur)
+     */
+    static std::vector<std::unique_ptr<Shader>> createPrograms(const std::vector<ProgramSource>& sources);
+
+    static bool isBinaryCacheSupported();
+    static bool isParallelCompileSupported();
+
 private:
+    Shader() = default;
+
+    /**
+     * @brief Charge le binaire en cache ou soumet compilation + linkage sans attendre
+     */
+    void begin(const ProgramSource& source);
+
+    /**
+     * @brief Vrai quand finish() ne bloquera plus (toujours vrai sans compilation parallèle)
+     */
+    bool isLinkComplete() const;
+
+    /**
+     * @brief Vérifie compilation/linkage puis écrit le binaire en cache
+     */
+    void finish();
+
+    bool loadBinary();
+    bool saveBinary() const;
+    std::string getCachePath() const;
+
     /**
      * @brief Compile un shader individuel
      * @param source Code source GLSL
-     * @param type GL_VERTEX_SHADER ou GL_FRAGMENT_SHADER
-     * @return ID du shader compilé
+     * @param type GL_VERTEX_SHADER, GL_GEOMETRY_SHADER ou GL_FRAGMENT_SHADER
+     * @return ID du shader (erreurs vérifiées par finish())
      */
     GLuint compileShader(const std::string& source, GLenum type);
 
     /**
-     * @brief Linke vertex + fragment en programme
+     * @brief Linke vertex + fragment en programme (sans attendre le résultat)
      */
-    void linkProgram(GLuint vertexID, GLuint fragmentID);
+    void linkProgram(GLuint vertexID, GLuint geometryID, GLuint fragmentID);
 
     /**
      * @brief Vérifie les erreurs de compilation/linkage
@@ -88,8 +156,31 @@ private:
     /**
      * @brief Charge le contenu d'un fichier shader
      */
-    std::string loadShaderFile(const std::string& path);
+    static std::string loadShaderFile(const std::string& path);
 
-    GLuint m_programID;
+    struct BinaryHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t binaryFormat;
+        uint64_t binarySize;
+        uint64_t sourceHash;
+        uint64_t driverHash;
+    };
+
+    static constexpr uint32_t CACHE_VERSION = 1;
+
+    static const std::string& getDriverString();
+
+    GLuint m_programID = 0;
+    GLuint m_pendingVertex = 0;     // non nuls entre begin() et finish()
+    GLuint m_pendingFragment = 0;
+    GLuint m_pendingGeometry = 0;   // 0 aussi quand le programme n'en a pas
+    uint64_t m_sourceHash = 0;
+    std::string m_label;
+    bool m_fromCache = false;
+    bool m_warnMissingUniforms = true;
     std::unordered_map<std::string, GLint> m_uniformCache;
+
+    static int s_binaryCacheSupport;      // -1 : pas encore testé
+    static int s_parallelCompileSupport;
 };
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "EntityStore.h"
+
+#include <utility>
+
+void EntityStore::reserve(size_t count) {
+    m_objects.reserve(count);
+    m_pickables.reserve(count);
+    m_handles.reserve(count);
+    m_slots.reserve(count);
+}
+
+EntityHandle EntityStore::create() {
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.push_back(Slot{});
+    }
+
+    Slot& entry = m_slots[slot];
+    entry.dense = static_cast<uint32_t>(m_objects.size());
+    entry.alive = true;
+
+    EntityHandle handle;
+    handle.slot = slot;
+    handle.generation = entry.generation;
+
+    m_objects.emplace_back();
+    m_pickables.push_back(NOT_PICKABLE);
+    m_handles.push_back(handle);
+    return handle;
+}
+
+void EntityStore::destroy(EntityHandle handle) {
+    if (!isAlive(handle)) return;
+
+    Slot& entry = m_slots[handle.slot];
+    const uint32_t dense = entry.dense;
+    const uint32_t last = static_cast<uint32_t>(m_objects.size()) - 1;
+
+    // Swap-and-pop : la dernière entité prend la place libérée
+    if (dense != last) {
+        m_objects[dense] = std::move(m_objects[last]);
+        m_pickables[dense] = m_pickables[last];
+        m_handles[dense] = m_handles[last];
+        m_slots[m_handles[dense].slot].dense = dense;
+    }
+    m_objects.pop_back();
+    m_pickables.pop_back();
+    m_handles.pop_back();
+
+    entry.alive = false;
+    ++entry.generation;
+    m_freeSlots.push_back(handle.slot);
+}
+
+void EntityStore::clear() {
+    for (const EntityHandle& handle : m_handles) {
+        Slot& entry = m_slots[handle.slot];
+        entry.alive = false;
+        ++entry.generation;
+        m_freeSlots.push_back(handle.slot);
+    }
+    m_objects.clear();
+    m_pickables.clear();
+    m_handles.clear();
+}
+
+bool EntityStore::isAlive(EntityHandle handle) const {
+    if (!handle.isValid() || handle.slot >= m_slots.size()) return false;
+    const Slot& entry = m_slots[handle.slot];
+    return entry.alive && entry.generation == handle.generation;
+}
+
+GameObject* EntityStore::get(EntityHandle handle) {
+    return isAlive(handle) ? &m_objects[m_slots[handle.slot].dense] : nullptr;
+}
+
+const GameObject* EntityStore::get(EntityHandle handle) const {
+    return isAlive(handle) ? &m_objects[m_slots[handle.slot].dense] : nullptr;
+}
+
+int EntityStore::indexOf(EntityHandle handle) const {
+    return isAlive(handle) ? static_cast<int>(m_slots[handle.slot].dense) : -1;
+}
+
+void EntityStore::setPickable(EntityHandle handle, int pickId) {
+    if (isAlive(handle)) m_pickables[m_slots[handle.slot].dense] = pickId;
+}
+
+int EntityStore::getPickable(EntityHandle handle) const {
+    return isAlive(handle) ? m_pickables[m_slots[handle.slot].dense] : NOT_PICKABLE;
+}
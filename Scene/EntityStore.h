@@ -0,0 +1,96 @@
+#pragma once
+
+#include "GameObject.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @struct EntityHandle
+ * @brief Référence stable vers une entité : emplacement + génération
+ *
+ * Une poignée sur une entité détruite ne résout plus, même quand son
+ * emplacement a été réutilisé par une nouvelle entité.
+ */
+struct EntityHandle {
+    static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+    uint32_t slot = INVALID;
+    uint32_t generation = 0;
+
+    bool isValid() const { return slot != INVALID; }
+
+    // Clé unique (tables de correspondance entre copies)
+    uint64_t getKey() const { return (static_cast<uint64_t>(generation) << 32) | slot; }
+
+    bool operator==(const EntityHandle& other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+/**
+ * @class EntityStore
+ * @brief Entités de la scène rangées dans des tableaux denses, accessibles par poignée
+ *
+ * - Composants indexés par position dense : GameObject (transform, mesh/LOD,
+ *   matériau, texture) et pickable (identifiant de sélection, -1 sinon)
+ * - Poignées stables : emplacement -> position dense, génération incrémentée
+ *   à la destruction
+ * - destroy() : la dernière entité comble le trou (swap-and-pop), les tableaux
+ *   restent contigus ; l'ordre dense ne change qu'à la destruction
+ *
+ * Les pointeurs rendus par get() ne survivent pas à create() / destroy().
+ */
+class EntityStore {
+public:
+    static constexpr int NOT_PICKABLE = -1;
+
+    void reserve(size_t count);
+
+    EntityHandle create();
+
+    /**
+     * @brief Détruit l'entité ; sans effet sur une poignée invalide ou périmée
+     */
+    void destroy(EntityHandle handle);
+    void clear();
+
+    bool isAlive(EntityHandle handle) const;
+
+    /**
+     * @brief Objet de l'entité, nullptr si la poignée est périmée
+     */
+    GameObject* get(EntityHandle handle);
+    const GameObject* get(EntityHandle handle) const;
+
+    /**
+     * @brief Position dans les tableaux denses, -1 si la poignée est périmée
+     */
+    int indexOf(EntityHandle handle) const;
+
+    void setPickable(EntityHandle handle, int pickId);
+    int getPickable(EntityHandle handle) const;
+
+    // Tableaux denses, alignés sur le même index
+    std::vector<GameObject>& getObjects() { return m_objects; }
+    const std::vector<GameObject>& getObjects() const { return m_objects; }
+    const std::vector<int>& getPickables() const { return m_pickables; }
+    const std::vector<EntityHandle>& getHandles() const { return m_handles; }
+    size_t size() const { return m_objects.size(); }
+
+private:
+    struct Slot {
+        uint32_t dense = 0;
+        uint32_t generation = 0;
+        bool alive = false;
+    };
+
+    // Composants (denses)
+    std::vector<GameObject> m_objects;
+    std::vector<int> m_pickables;
+    std::vector<EntityHandle> m_handles;   // position dense -> poignée
+
+    // Emplacements (clairsemés)
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+};
@@ -3,31 +3,107 @@
 #include "Rendering/Material.h"
 #include "Transform.h"
 #include "Rendering/shader.h"
+#include "Rendering/MeshLOD.h"
+#include "Rendering/TextureManager.h"
+
+#include <memory>
 
 class GameObject {
 public:
-    GameObject() : m_mesh(nullptr), m_visible(true) {}
-    
-    ~GameObject() {
-        if (m_mesh) delete m_mesh;
-    }
+    GameObject() : m_visible(true), m_lodLevel(0), m_texture(0), m_textureLayer(-1) {}
 
     Transform& getTransform() { return m_transform; }
     const Transform& getTransform() const { return m_transform; }
 
-    void setMesh(Mesh* mesh) { 
-        if (m_mesh) delete m_mesh;
-        m_mesh = mesh; 
+    // Takes ownership of the mesh
+    void setMesh(Mesh* mesh) {
+        m_mesh.reset(mesh);
+    }
+
+    // Shares one GPU mesh between several objects (seeds, pits...)
+    void setMesh(std::shared_ptr<Mesh> mesh) {
+        m_mesh = std::move(mesh);
+    }
+
+    Mesh* getMesh() const { return m_mesh.get(); }
+
+    // Shares a LOD chain; the active mesh starts at the finest level
+    void setLOD(std::shared_ptr<MeshLOD> lod) {
+        m_lod = std::move(lod);
+        m_lodLevel = 0;
+        if (m_lod && m_lod->getLevelCount() > 0) m_mesh = m_lod->getLevel(0).mesh;
+    }
+
+    const MeshLOD* getLOD() const { return m_lod.get(); }
+    int getLODLevel() const { return m_lodLevel; }
+
+    // Switches the active mesh to the level picked for this projected size (pixels).
+    // A negative size forces the finest level.
+    void updateLOD(float screenSize) {
+        if (!m_lod || m_lod->getLevelCount() == 0) return;
+        int level = (screenSize < 0.0f) ? 0 : m_lod->selectLevel(screenSize, m_lodLevel);
+        if (level != m_lodLevel || m_mesh != m_lod->getLevel(level).mesh) {
+            m_lodLevel = level;
+            m_mesh = m_lod->getLevel(level).mesh;
+        }
+    }
+
+    // Restores a level chosen earlier (render-side copies from simulation snapshots
+    // keep their hysteresis across snapshots)
+    void setLODLevel(int level) {
+        if (!m_lod || level < 0 || level >= static_cast<int>(m_lod->getLevelCount())) return;
+        m_lodLevel = level;
+        m_mesh = m_lod->getLevel(level).mesh;
+    }
+
+    void setMaterial(const Material& material) {
+        m_material = material;
     }
-    
-    void setMaterial(const Material& material) { 
-        m_material = material; 
+
+    const Material& getMaterial() const { return m_material; }
+
+    // Diffuse texture: one layer of a TextureManager::loadTextureArrayAsync array
+    // (0 / negative layer = material color only). The handle resolves to a
+    // placeholder until the upload completes.
+    void setTexture(TextureHandle textureArray, int layer) {
+        m_texture = (layer >= 0) ? textureArray : 0;
+        m_textureLayer = (m_texture != 0) ? layer : -1;
     }
+    TextureHandle getTexture() const { return m_texture; }
+    int getTextureLayer() const { return m_textureLayer; }
+
+    // Objects sharing a texture array skip the rebind; call before a batch of
+    // render() calls, since other code (ImGui...) also binds texture unit 0
+    static void resetTextureBinding() { s_boundTexture = 0; }
+
+    // Reference shader (USE_INVERSE_NORMALS): upload the bare model matrix as
+    // "objectModel" instead of the cached normal matrix
+    static void setInverseNormalReference(bool enabled) { s_inverseNormalReference = enabled; }
 
     void setVisible(bool visible) { m_visible = visible; }
     bool isVisible() const { return m_visible; }
 
-    void render(Shader& shader) {
+    // World-space AABB (center + half extents) of the mesh bounds under the model matrix.
+    // Returns false when there is no mesh.
+    bool getWorldBounds(glm::vec3& outCenter, glm::vec3& outExtent) const {
+        if (!m_mesh) return false;
+
+        glm::mat4 model = m_transform.getModelMatrix();
+        glm::vec3 localCenter = m_mesh->getBoundsCenter();
+        glm::vec3 localExtent = (m_mesh->getBoundsMax() - m_mesh->getBoundsMin()) * 0.5f;
+
+        // Arvo: extent' = |M3| * extent
+        glm::mat3 absRot(glm::abs(glm::vec3(model[0])),
+                         glm::abs(glm::vec3(model[1])),
+                         glm::abs(glm::vec3(model[2])));
+
+        outCenter = glm::vec3(model * glm::vec4(localCenter, 1.0f));
+        outExtent = absRot * localExtent;
+        return true;
+    }
+
+    // textured: the shader is a USE_TEXTURE variant (binds the texture array + layer)
+    void render(Shader& shader, bool textured) {
         if (!m_visible || !m_mesh) return;
 
         // Set material uniforms
@@ -36,8 +112,31 @@ public:
         shader.setVec3("material.specular", m_material.specular);
         shader.setFloat("material.shininess", m_material.shininess);
 
+        if (textured) {
+            GLuint textureID = TextureManager::getInstance().getTextureID(m_texture);
+            if (textureID != s_boundTexture) {
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+                shader.setInt("diffuseTextures", 0);
+                s_boundTexture = textureID;
+            }
+            shader.setInt("diffuseLayer", m_textureLayer);
+        }
+
         // Set model matrix - FIXED METHOD NAME
-        shader.setMat4("model", m_transform.getModelMatrix());
+        // (packed meshes store positions relative to their bounds: fold the dequantization in)
+        if (m_mesh->getVertexFormat() == VertexFormat::PACKED) {
+            shader.setMat4("model", m_transform.getModelMatrix() * m_mesh->getPositionTransform());
+        } else {
+            shader.setMat4("model", m_transform.getModelMatrix());
+        }
+
+        // Normal matrix cached with the model matrix (no per-vertex inverse)
+        if (s_inverseNormalReference) {
+            shader.setMat4("objectModel", m_transform.getModelMatrix());
+        } else {
+            shader.setMat3("normalMatrix", m_transform.getNormalMatrix());
+        }
 
         // Render mesh
         m_mesh->draw();
@@ -45,7 +144,14 @@ public:
 
 private:
     Transform m_transform;
-    Mesh* m_mesh;
+    std::shared_ptr<Mesh> m_mesh;
+    std::shared_ptr<MeshLOD> m_lod;
     Material m_material;
     bool m_visible;
-};
\ No newline at end of file
+    int m_lodLevel;
+    TextureHandle m_texture;
+    int m_textureLayer;
+
+    static inline GLuint s_boundTexture = 0;
+    static inline bool s_inverseNormalReference = false;
+};
@@ -0,0 +1,258 @@
+#include "SceneBVH.h"
+#include "GameObject.h"
+
+#include <algorithm>
+#include <numeric>
+
+void SceneBVH::update(const std::vector<GameObject*>& objects) {
+    const size_t count = objects.size();
+    const bool resized = count != m_objects.size();
+    m_objects = objects;
+
+    if (resized) {
+        m_boundsMin.assign(count, glm::vec3(0.0f));
+        m_boundsMax.assign(count, glm::vec3(0.0f));
+        m_centers.assign(count, glm::vec3(0.0f));
+        m_versions.assign(count, 0);
+        m_meshes.assign(count, nullptr);
+        m_hasBounds.assign(count, 0);
+        for (size_t i = 0; i < count; ++i) {
+            updateObjectBounds(static_cast<int>(i));
+        }
+        rebuild();
+        return;
+    }
+
+    // Refit : seuls les objets modifiés, puis leurs ancêtres
+    std::fill(m_dirty.begin(), m_dirty.end(), 0);
+    size_t changed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (!updateObjectBounds(static_cast<int>(i))) continue;
+        ++changed;
+        m_leafBoxes.set(m_slotOf[i], m_boundsMin[i], m_boundsMax[i]);
+        for (int node = m_leafOf[i]; node >= 0 && !m_dirty[node]; node = m_nodes[node].parent) {
+            m_dirty[node] = 1;
+        }
+    }
+    if (changed == 0) return;
+
+    if (changed > static_cast<size_t>(REBUILD_FRACTION * static_cast<float>(count))) {
+        rebuild();
+        return;
+    }
+
+    // Enfants toujours après leur parent : un parcours à rebours remonte les boîtes
+    for (size_t n = m_nodes.size(); n-- > 0;) {
+        if (m_dirty[n]) computeNodeBounds(m_nodes[n]);
+    }
+    ++m_refitCount;
+    m_lastRefitObjects = changed;
+}
+
+bool SceneBVH::updateObjectBounds(int index) {
+    const GameObject* object = m_objects[index];
+    const uint64_t version = object ? object->getTransform().getVersion() : 0;
+    const Mesh* mesh = object ? object->getMesh() : nullptr;
+    if (version == m_versions[index] && mesh == m_meshes[index]) return false;
+
+    m_versions[index] = version;
+    m_meshes[index] = mesh;
+
+    glm::vec3 center, extent;
+    if (object && object->getWorldBounds(center, extent)) {
+        m_boundsMin[index] = center - extent;
+        m_boundsMax[index] = center + extent;
+        m_centers[index] = center;
+        m_hasBounds[index] = 1;
+    } else {
+        // Gardé pour la stabilité des index, jamais touché par un rayon
+        glm::vec3 position = object ? object->getTransform().getPosition() : glm::vec3(0.0f);
+        m_boundsMin[index] = m_boundsMax[index] = m_centers[index] = position;
+        m_hasBounds[index] = 0;
+    }
+    return true;
+}
+
+void SceneBVH::rebuild() {
+    const int count = static_cast<int>(m_objects.size());
+
+    m_order.resize(count);
+    std::iota(m_order.begin(), m_order.end(), 0);
+    m_leafOf.assign(count, -1);
+    m_nodes.clear();
+
+    if (count > 0) {
+        m_nodes.reserve(2 * (count / MAX_LEAF_SIZE + 1));
+        m_nodes.push_back(Node{});
+        m_nodes[0].parent = -1;
+        buildNode(0, 0, count);
+    }
+
+    m_dirty.assign(m_nodes.size(), 0);
+
+    m_slotOf.assign(count, -1);
+    m_leafBoxes.resize(count);
+    for (int slot = 0; slot < count; ++slot) {
+        int object = m_order[slot];
+        m_slotOf[object] = slot;
+        m_leafBoxes.set(slot, m_boundsMin[object], m_boundsMax[object]);
+    }
+    ++m_rebuildCount;
+    m_lastRefitObjects = static_cast<size_t>(count);
+}
+
+void SceneBVH::buildNode(int nodeIndex, int first, int count) {
+    m_nodes[nodeIndex].first = first;
+    m_nodes[nodeIndex].count = count;
+
+    glm::vec3 centerMin(FLT_MAX), centerMax(-FLT_MAX);
+    for (int i = first; i < first + count; ++i) {
+        centerMin = glm::min(centerMin, m_centers[m_order[i]]);
+        centerMax = glm::max(centerMax, m_centers[m_order[i]]);
+    }
+
+    glm::vec3 spread = centerMax - centerMin;
+    int axis = (spread.x > spread.y && spread.x > spread.z) ? 0 : (spread.y > spread.z ? 1 : 2);
+
+    // Feuille : peu d'objets, ou tous les centres confondus (aucune coupe possible)
+    if (count <= MAX_LEAF_SIZE || spread[axis] <= 0.0f) {
+        for (int i = first; i < first + count; ++i) {
+            m_leafOf[m_order[i]] = nodeIndex;
+        }
+        computeNodeBounds(m_nodes[nodeIndex]);
+        return;
+    }
+
+    // Médiane : arbre équilibré quelle que soit la répartition
+    const int mid = first + count / 2;
+    std::nth_element(m_order.begin() + first, m_order.begin() + mid, m_order.begin() + first + count,
+                     [&](int a, int b) { return m_centers[a][axis] < m_centers[b][axis]; });
+
+    const int left = static_cast<int>(m_nodes.size());
+    m_nodes.push_back(Node{});
+    m_nodes.push_back(Node{});
+    m_nodes[left].parent = nodeIndex;
+    m_nodes[left + 1].parent = nodeIndex;
+    m_nodes[nodeIndex].first = left;
+    m_nodes[nodeIndex].count = 0;
+
+    buildNode(left, first, mid - first);
+    buildNode(left + 1, mid, first + count - mid);
+    computeNodeBounds(m_nodes[nodeIndex]);
+}
+
+void SceneBVH::computeNodeBounds(Node& node) const {
+    node.min = glm::vec3(FLT_MAX);
+    node.max = glm::vec3(-FLT_MAX);
+
+    if (node.count > 0) {
+        for (int i = node.first; i < node.first + node.count; ++i) {
+            int object = m_order[i];
+            if (!m_hasBounds[object]) continue;
+            node.min = glm::min(node.min, m_boundsMin[object]);
+            node.max = glm::max(node.max, m_boundsMax[object]);
+        }
+        return;
+    }
+
+    for (int child = node.first; child <= node.first + 1; ++child) {
+        node.min = glm::min(node.min, m_nodes[child].min);
+        node.max = glm::max(node.max, m_nodes[child].max);
+    }
+}
+
+bool SceneBVH::intersectBox(const glm::vec3& origin, const glm::vec3& invDirection,
+                            const glm::vec3& boxMin, const glm::vec3& boxMax,
+                            float maxDistance, float& outEnter, float& outExit) {
+    glm::vec3 t0 = (boxMin - origin) * invDirection;
+    glm::vec3 t1 = (boxMax - origin) * invDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+
+    outEnter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    outExit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+    return outEnter <= outExit;
+}
+
+template <typename Visit>
+void SceneBVH::traverse(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                        const Filter& filter, Visit&& visit) const {
+    if (m_nodes.empty()) return;
+
+    const glm::vec3 invDirection = 1.0f / direction;
+    float limit = maxDistance;
+
+    // Arbre équilibré (coupe médiane) : profondeur ~log2(n / MAX_LEAF_SIZE)
+    int stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const Node& node = m_nodes[stack[--top]];
+        float enter, exit;
+        if (!intersectBox(origin, invDirection, node.min, node.max, limit, enter, exit)) continue;
+
+        if (node.count > 0) {
+            // Boîtes de la feuille contiguës : un paquet SIMD par MAX_LEAF_SIZE objets
+            float distances[MAX_LEAF_SIZE];
+            for (int chunk = 0; chunk < node.count; chunk += MAX_LEAF_SIZE) {
+                int chunkSize = std::min(MAX_LEAF_SIZE, node.count - chunk);
+                m_leafBoxes.intersect(origin, invDirection, node.first + chunk, chunkSize, limit, distances);
+
+                for (int k = 0; k < chunkSize; ++k) {
+                    if (distances[k] == FLT_MAX) continue;   // manquée (le noyau borne déjà à limit)
+                    int index = m_order[node.first + chunk + k];
+                    const GameObject* object = m_objects[index];
+                    if (!m_hasBounds[index] || !object || !object->isVisible()) continue;
+                    if (filter && !filter(index)) continue;
+                    limit = visit(index, distances[k], limit);
+                }
+            }
+            continue;
+        }
+
+        // Enfant le plus proche dépilé en premier : élagage plus tôt
+        int nearChild = node.first, farChild = node.first + 1;
+        float nearEnter, farEnter, unused;
+        bool nearHit = intersectBox(origin, invDirection, m_nodes[nearChild].min, m_nodes[nearChild].max,
+                                    limit, nearEnter, unused);
+        bool farHit = intersectBox(origin, invDirection, m_nodes[farChild].min, m_nodes[farChild].max,
+                                   limit, farEnter, unused);
+        if (nearHit && farHit && farEnter < nearEnter) {
+            std::swap(nearChild, farChild);
+            std::swap(nearHit, farHit);
+        }
+        if (farHit && top < 64) stack[top++] = farChild;
+        if (nearHit && top < 64) stack[top++] = nearChild;
+    }
+}
+
+SceneBVH::Hit SceneBVH::raycast(const glm::vec3& origin, const glm::vec3& direction,
+                                float maxDistance, const Filter& filter) const {
+    Hit best;
+    traverse(origin, direction, maxDistance, filter, [&](int index, float distance, float limit) {
+        if (distance < best.distance) {
+            best.hit = true;
+            best.index = index;
+            best.object = m_objects[index];
+            best.distance = distance;
+        }
+        return std::min(limit, best.distance);
+    });
+    return best;
+}
+
+void SceneBVH::raycastAll(const glm::vec3& origin, const glm::vec3& direction, std::vector<Hit>& outHits,
+                          float maxDistance, const Filter& filter) const {
+    outHits.clear();
+    traverse(origin, direction, maxDistance, filter, [&](int index, float distance, float limit) {
+        Hit hit;
+        hit.hit = true;
+        hit.index = index;
+        hit.object = m_objects[index];
+        hit.distance = distance;
+        outHits.push_back(hit);
+        return limit;
+    });
+    std::sort(outHits.begin(), outHits.end(), [](const Hit& a, const Hit& b) { return a.distance < b.distance; });
+}
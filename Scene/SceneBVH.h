@@ -0,0 +1,120 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include "Interaction/AABBPacket.h"
+#include <cfloat>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class GameObject;
+class Mesh;
+
+/**
+ * @class SceneBVH
+ * @brief Hiérarchie de volumes englobants (AABB monde) sur une liste de GameObject
+ *
+ * - Construction descendante : coupe à la médiane des centres sur l'axe le plus long
+ * - update() ne recalcule que les objets dont le Transform (getVersion) ou le
+ *   mesh a changé, puis remonte les boîtes jusqu'à la racine (refit)
+ * - Reconstruction si la liste change de taille ou si trop d'objets ont bougé
+ *   (un refit sur des objets très déplacés donne des boîtes qui se chevauchent)
+ * - Requêtes de rayon : plus proche impact, ou tous les impacts triés
+ * - Boîtes des objets rangées dans l'ordre des feuilles (AABBPacket) : une
+ *   feuille se teste en un seul paquet SIMD
+ *
+ * Les objets sans mesh sont gardés (indices stables) mais jamais touchés.
+ */
+class SceneBVH {
+public:
+    struct Hit {
+        GameObject* object = nullptr;
+        int index = -1;              // index dans la liste passée à update()
+        float distance = FLT_MAX;    // le long du rayon, direction normalisée
+        bool hit = false;
+    };
+
+    // Filtre optionnel sur l'index d'objet (ex : seulement les pits)
+    using Filter = std::function<bool(int)>;
+
+    static constexpr int MAX_LEAF_SIZE = 4;
+    static constexpr float REBUILD_FRACTION = 0.5f;   // part d'objets modifiés déclenchant une reconstruction
+
+    /**
+     * @brief Synchronise l'arbre avec la liste (mêmes index que les requêtes)
+     */
+    void update(const std::vector<GameObject*>& objects);
+
+    /**
+     * @brief Impact le plus proche sur les boîtes des objets visibles
+     */
+    Hit raycast(const glm::vec3& origin, const glm::vec3& direction,
+                float maxDistance = FLT_MAX, const Filter& filter = nullptr) const;
+
+    /**
+     * @brief Tous les impacts, du plus proche au plus lointain
+     */
+    void raycastAll(const glm::vec3& origin, const glm::vec3& direction, std::vector<Hit>& outHits,
+                    float maxDistance = FLT_MAX, const Filter& filter = nullptr) const;
+
+    size_t getObjectCount() const { return m_objects.size(); }
+    size_t getNodeCount() const { return m_nodes.size(); }
+    uint64_t getRebuildCount() const { return m_rebuildCount; }
+    uint64_t getRefitCount() const { return m_refitCount; }
+    size_t getLastRefitObjects() const { return m_lastRefitObjects; }
+
+private:
+    struct Node {
+        glm::vec3 min;
+        int first;       // feuille : premier élément de m_order ; interne : enfant gauche (droit = first + 1)
+        glm::vec3 max;
+        int count;       // > 0 : feuille
+        int parent;
+    };
+
+    /**
+     * @brief Recalcule la boîte d'un objet ; false si rien n'a changé
+     */
+    bool updateObjectBounds(int index);
+
+    void rebuild();
+    void buildNode(int nodeIndex, int first, int count);
+    void computeNodeBounds(Node& node) const;
+
+    /**
+     * @brief Parcours du plus proche au plus lointain ; visit(index, distance, limite)
+     * renvoie la nouvelle limite de distance (élagage des nœuds plus lointains)
+     */
+    template <typename Visit>
+    void traverse(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                  const Filter& filter, Visit&& visit) const;
+
+    /**
+     * @brief Test des dalles ; entrée bornée à 0 (origine dans la boîte), sortie à maxDistance
+     */
+    static bool intersectBox(const glm::vec3& origin, const glm::vec3& invDirection,
+                             const glm::vec3& boxMin, const glm::vec3& boxMax,
+                             float maxDistance, float& outEnter, float& outExit);
+
+    std::vector<GameObject*> m_objects;
+
+    // Par objet
+    std::vector<glm::vec3> m_boundsMin;
+    std::vector<glm::vec3> m_boundsMax;
+    std::vector<glm::vec3> m_centers;
+    std::vector<uint64_t> m_versions;
+    std::vector<const Mesh*> m_meshes;
+    std::vector<uint8_t> m_hasBounds;
+    std::vector<int> m_leafOf;
+    std::vector<int> m_slotOf;         // position dans m_order / m_leafBoxes
+
+    // Arbre
+    std::vector<Node> m_nodes;
+    std::vector<int> m_order;          // index d'objets regroupés par feuille
+    AABBPacket m_leafBoxes;            // boîtes dans l'ordre de m_order
+    std::vector<uint8_t> m_dirty;      // par nœud, pendant un refit
+
+    uint64_t m_rebuildCount = 0;
+    uint64_t m_refitCount = 0;
+    size_t m_lastRefitObjects = 0;
+};
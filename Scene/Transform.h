@@ -3,13 +3,16 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
+#include <atomic>
+#include <cstdint>
 
 /**
  * @class Transform
  * @brief Représentation TRS (Translation-Rotation-Scale) d'un objet 3D
  * 
  * Utilise quaternions pour rotations (évite gimbal lock)
- * Cache la matrice Model pour optimisation
+ * Cache la matrice Model pour optimisation (ou matrices fournies par TransformSystem)
+ * Numéro de version par modification (refit incrémental du SceneBVH)
  */
 class Transform {
 public:
@@ -18,18 +21,19 @@ public:
         , m_rotation(1.0f, 0.0f, 0.0f, 0.0f) // Quaternion identité
         , m_scale(1.0f)
         , m_modelMatrixDirty(true)
+        , m_version(nextVersion())
     {}
 
     // ===== SETTERS =====
     
     void setPosition(const glm::vec3& position) {
         m_position = position;
-        m_modelMatrixDirty = true;
+        touch();
     }
     
     void setRotation(const glm::quat& rotation) {
         m_rotation = rotation;
-        m_modelMatrixDirty = true;
+        touch();
     }
     
     /**
@@ -37,12 +41,12 @@ public:
      */
     void setRotationEuler(float pitch, float yaw, float roll) {
         m_rotation = glm::quat(glm::radians(glm::vec3(pitch, yaw, roll)));
-        m_modelMatrixDirty = true;
+        touch();
     }
     
     void setScale(const glm::vec3& scale) {
         m_scale = scale;
-        m_modelMatrixDirty = true;
+        touch();
     }
     
     void setScale(float uniformScale) {
@@ -64,7 +68,34 @@ public:
         }
         return m_modelMatrix;
     }
+
+    /**
+     * @brief Retourne la matrice des normales transpose(inverse(mat3(Model))) (avec cache)
+     * Recalculée avec la matrice Model, une fois par changement et non par vertex.
+     */
+    glm::mat3 getNormalMatrix() const {
+        if (m_modelMatrixDirty) {
+            updateModelMatrix();
+        }
+        return m_normalMatrix;
+    }
     
+    /**
+     * @brief Remplace le cache par des matrices calculées en lot (TransformSystem,
+     * parent compris) ; valables jusqu'à la prochaine modification
+     */
+    void setComputedMatrices(const glm::mat4& model, const glm::mat3& normal) {
+        m_modelMatrix = model;
+        m_normalMatrix = normal;
+        m_modelMatrixDirty = false;
+    }
+
+    /**
+     * @brief Identifiant de l'état courant : change à chaque modification et
+     * n'est partagé qu'avec les copies de ce même état (snapshots)
+     */
+    uint64_t getVersion() const { return m_version; }
+
     /**
      * @brief Direction "avant" de l'objet
      */
@@ -84,7 +115,7 @@ public:
     
     void translate(const glm::vec3& delta) {
         m_position += delta;
-        m_modelMatrixDirty = true;
+        touch();
     }
     
     void rotate(float angleDegrees, const glm::vec3& axis) {
@@ -93,12 +124,12 @@ public:
             glm::normalize(axis)
         );
         m_rotation = deltaRotation * m_rotation;
-        m_modelMatrixDirty = true;
+        touch();
     }
     
     void scale(const glm::vec3& factor) {
         m_scale *= factor;
-        m_modelMatrixDirty = true;
+        touch();
     }
     
     /**
@@ -108,10 +139,21 @@ public:
         glm::vec3 direction = glm::normalize(target - m_position);
         glm::mat4 lookAtMatrix = glm::lookAt(m_position, target, worldUp);
         m_rotation = glm::quat_cast(glm::inverse(lookAtMatrix));
-        m_modelMatrixDirty = true;
+        touch();
     }
 
 private:
+    void touch() {
+        m_modelMatrixDirty = true;
+        m_version = nextVersion();
+    }
+
+    // Compteur global : deux Transform distincts n'ont jamais la même version
+    static uint64_t nextVersion() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
     /**
      * @brief Recalcule la matrice Model
      * Ordre : Scale → Rotate → Translate
@@ -127,6 +169,12 @@ private:
         
         // Scale
         m_modelMatrix = glm::scale(m_modelMatrix, m_scale);
+
+        // Normales : transpose(inverse(R * S)) = R * S^-1 (pas d'inversion générale)
+        glm::mat3 rotation = glm::mat3_cast(m_rotation);
+        for (int i = 0; i < 3; ++i) {
+            m_normalMatrix[i] = (m_scale[i] != 0.0f) ? rotation[i] / m_scale[i] : glm::vec3(0.0f);
+        }
         
         m_modelMatrixDirty = false;
     }
@@ -136,5 +184,7 @@ private:
     glm::vec3 m_scale;
     
     mutable glm::mat4 m_modelMatrix;
+    mutable glm::mat3 m_normalMatrix;
     mutable bool m_modelMatrixDirty;
+    uint64_t m_version;
 };
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "TransformSystem.h"
+#include "GameObject.h"
+
+#include <algorithm>
+
+void TransformSystem::resize(size_t count) {
+    const size_t previous = size();
+    m_positions.resize(count, glm::vec3(0.0f));
+    m_rotations.resize(count, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    m_scales.resize(count, glm::vec3(1.0f));
+    m_world.resize(count, glm::mat4(1.0f));
+    m_normal.resize(count, glm::mat3(1.0f));
+    m_versions.resize(count, 0);
+    m_dirty.resize(count, 1);
+
+    // Index retirés : plus rien à recalculer ni à écrire pour eux
+    auto removed = [count](int i) { return static_cast<size_t>(i) >= count; };
+    m_dirtyList.erase(std::remove_if(m_dirtyList.begin(), m_dirtyList.end(), removed), m_dirtyList.end());
+    m_updated.erase(std::remove_if(m_updated.begin(), m_updated.end(), removed), m_updated.end());
+    for (size_t i = previous; i < count; ++i) {
+        m_dirtyList.push_back(static_cast<int>(i));
+    }
+}
+
+void TransformSystem::setLocal(int index, const glm::vec3& position, const glm::quat& rotation,
+                               const glm::vec3& scale) {
+    m_positions[index] = position;
+    m_rotations[index] = rotation;
+    m_scales[index] = scale;
+    if (!m_dirty[index]) {
+        m_dirty[index] = 1;
+        m_dirtyList.push_back(index);
+    }
+}
+
+void TransformSystem::update() {
+    // Matrices : éléments indépendants, mais lus via m_dirtyList et
+    // mat3_cast par quaternion, donc boucle scalaire ; le gain vient de ne
+    // traiter que les transforms modifiés
+    for (int i : m_dirtyList) {
+        const glm::mat3 rotation = glm::mat3_cast(m_rotations[i]);
+        const glm::vec3& scale = m_scales[i];
+
+        glm::mat4& world = m_world[i];
+        world[0] = glm::vec4(rotation[0] * scale.x, 0.0f);
+        world[1] = glm::vec4(rotation[1] * scale.y, 0.0f);
+        world[2] = glm::vec4(rotation[2] * scale.z, 0.0f);
+        world[3] = glm::vec4(m_positions[i], 1.0f);
+
+        // transpose(inverse(R * S)) = R * S^-1
+        glm::mat3& normal = m_normal[i];
+        for (int axis = 0; axis < 3; ++axis) {
+            normal[axis] = (scale[axis] != 0.0f) ? rotation[axis] / scale[axis] : glm::vec3(0.0f);
+        }
+    }
+
+    for (int i : m_dirtyList) m_dirty[i] = 0;
+    m_updated.swap(m_dirtyList);
+    m_dirtyList.clear();
+    m_lastUpdateCount = m_updated.size();
+}
+
+void TransformSystem::sync(const std::vector<GameObject>& objects) {
+    if (objects.size() != size()) {
+        m_positions.clear();
+        m_rotations.clear();
+        m_scales.clear();
+        m_world.clear();
+        m_normal.clear();
+        m_versions.clear();
+        m_dirty.clear();
+        m_dirtyList.clear();
+        m_updated.clear();
+        resize(objects.size());
+    }
+
+    for (size_t i = 0; i < objects.size(); ++i) {
+        const Transform& transform = objects[i].getTransform();
+        if (transform.getVersion() == m_versions[i]) continue;
+
+        m_versions[i] = transform.getVersion();
+        setLocal(static_cast<int>(i), transform.getPosition(), transform.getRotation(), transform.getScale());
+    }
+}
+
+void TransformSystem::apply(std::vector<GameObject>& objects) const {
+    for (int i : m_updated) {
+        if (static_cast<size_t>(i) < objects.size()) {
+            objects[i].getTransform().setComputedMatrices(m_world[i], m_normal[i]);
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <vector>
+
+class GameObject;
+
+/**
+ * @class TransformSystem
+ * @brief Transforms stockés en SoA (positions, rotations, échelles contiguës)
+ * et matrices monde recalculées en un seul passage par lot
+ *
+ * - Liste des transforms modifiés, tenue par setLocal() : update() ne recalcule
+ *   qu'eux, sans parcourir les autres
+ * - Pas de hiérarchie : les objets du jeu sont en coordonnées monde, et leurs
+ *   index denses changent (swap-and-pop de l'EntityStore)
+ * - sync() / apply() : pont avec les Transform d'un tableau dense de GameObject
+ *   (mêmes index), modification détectée par Transform::getVersion ; apply()
+ *   n'écrit que les matrices recalculées, les autres caches restent valides
+ *
+ * Utilisé sur les objets du jeu (thread de simulation), qui vivent d'un pas à
+ * l'autre : les copies du snapshot héritent de caches déjà à jour et le rendu
+ * ne recalcule aucune matrice.
+ *
+ * Matrice des normales : R × S^-1 (inverse-transposée de R × S, sans inversion).
+ */
+class TransformSystem {
+public:
+    /**
+     * @brief Nombre de transforms ; les nouveaux sont l'identité
+     */
+    void resize(size_t count);
+    size_t size() const { return m_positions.size(); }
+
+    void setLocal(int index, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+
+    /**
+     * @brief Recalcule les matrices des transforms modifiés depuis le dernier appel
+     */
+    void update();
+
+    const glm::mat4& getWorldMatrix(int index) const { return m_world[index]; }
+    const glm::mat3& getNormalMatrix(int index) const { return m_normal[index]; }
+
+    /**
+     * @brief Reprend les TRS des objets dont le Transform a changé ; un tableau de
+     * taille différente réinitialise tout
+     */
+    void sync(const std::vector<GameObject>& objects);
+
+    /**
+     * @brief Écrit dans le cache des Transform les matrices du dernier update()
+     * (index recalculés seulement)
+     */
+    void apply(std::vector<GameObject>& objects) const;
+
+    size_t getLastUpdateCount() const { return m_lastUpdateCount; }
+
+private:
+    // Local (SoA)
+    std::vector<glm::vec3> m_positions;
+    std::vector<glm::quat> m_rotations;
+    std::vector<glm::vec3> m_scales;
+
+    // Résultats
+    std::vector<glm::mat4> m_world;
+    std::vector<glm::mat3> m_normal;
+
+    std::vector<uint64_t> m_versions;  // Transform::getVersion vu au dernier sync()
+    std::vector<uint8_t> m_dirty;
+    std::vector<int> m_dirtyList;      // modifiés en attente de update()
+    std::vector<int> m_updated;        // recalculés par le dernier update() (pour apply)
+
+    size_t m_lastUpdateCount = 0;
+};
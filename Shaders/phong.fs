@@ -1,11 +1,15 @@
 #version 330 core
 
-#define MAX_LIGHTS 4
+// Must match LightClusterer::GRID_X/Y/Z
+#define CLUSTER_GRID_X 16
+#define CLUSTER_GRID_Y 9
+#define CLUSTER_GRID_Z 24
 
 struct Light {
     vec3 position;
     vec3 color;
     float intensity;
+    float radius;
 };
 
 struct Material {
@@ -19,20 +23,54 @@ in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoord;
 
+#ifdef USE_WIREFRAME
+noperspective in vec3 Barycentric;   // from wireframe.gs
+uniform vec3 wireframeColor;
+uniform float wireframeWidth;        // pixels
+#endif
+
 out vec4 FragColor;
 
 // Uniforms
 uniform vec3 viewPos;
-uniform int numLights;
-uniform Light lights[MAX_LIGHTS];
+uniform mat4 view;
+
+// Clustered lights (texture buffers filled by LightClusterer)
+uniform samplerBuffer  clusterLights;    // 2 texels per light: (position, radius), (color, intensity)
+uniform usamplerBuffer clusterRanges;    // (offset, count) per cluster
+uniform usamplerBuffer clusterIndices;   // light indices, grouped by cluster
+uniform vec2 clusterTileScale;           // grid.xy / screen size
+uniform vec2 clusterDepthParams;         // slice = log(viewDepth) * x + y
 uniform Material material;
 
-uniform bool useTextures;
-uniform sampler2D texture_diffuse1;
-uniform bool hasTexture;
+// Permutations (ShaderPermutations): USE_TEXTURE, USE_LIGHTING, USE_WIREFRAME
+#ifdef USE_TEXTURE
+uniform sampler2DArray diffuseTextures;   // theme texture array
+uniform int diffuseLayer;
+#endif
+
+Light fetchLight(int index) {
+    vec4 positionRadius = texelFetch(clusterLights, index * 2);
+    vec4 colorIntensity = texelFetch(clusterLights, index * 2 + 1);
+
+    Light light;
+    light.position  = positionRadius.xyz;
+    light.radius    = positionRadius.w;
+    light.color     = colorIntensity.rgb;
+    light.intensity = colorIntensity.a;
+    return light;
+}
+
+int clusterIndex() {
+    float viewDepth = -(view * vec4(FragPos, 1.0)).z;
+
+    ivec3 cluster;
+    cluster.xy = ivec2(gl_FragCoord.xy * clusterTileScale);
+    cluster.z  = int(log(max(viewDepth, 1e-4)) * clusterDepthParams.x + clusterDepthParams.y);
+    cluster = clamp(cluster, ivec3(0), ivec3(CLUSTER_GRID_X - 1, CLUSTER_GRID_Y - 1, CLUSTER_GRID_Z - 1));
 
-// NEW: lighting toggle
-uniform bool lightingEnabled;
+    return cluster.x + CLUSTER_GRID_X * (cluster.y + CLUSTER_GRID_Y * cluster.z);
+}
 
 vec3 calculateLight(Light light, vec3 normal, vec3 viewDir, vec3 materialDiffuse) {
     // Ambient
@@ -48,9 +86,11 @@ vec3 calculateLight(Light light, vec3 normal, vec3 viewDir, vec3 materialDiffuse
     float spec = pow(max(dot(normal, halfwayDir), 0.0), material.shininess);
     vec3 specular = light.color * (spec * material.specular);
 
-    // Attenuation (distance falloff)
+    // Attenuation (distance falloff), windowed to reach zero at the light radius
     float distance = length(light.position - FragPos);
     float attenuation = 1.0 / (1.0 + 0.045 * distance + 0.0075 * distance * distance);
+    float falloff = clamp(1.0 - pow(distance / light.radius, 4.0), 0.0, 1.0);
+    attenuation *= falloff * falloff;
 
     return (ambient + diffuse + specular) * light.intensity * attenuation;
 }
@@ -60,32 +100,36 @@ void main() {
     vec3 viewDir = normalize(viewPos - FragPos);
 
     // Base color (texture or material)
-    vec3 baseColor;
-    if (useTextures && hasTexture) {
-        baseColor = texture(texture_diffuse1, TexCoord).rgb;
-    } else {
-        baseColor = material.diffuse;
-    }
+#ifdef USE_TEXTURE
+    vec3 baseColor = texture(diffuseTextures, vec3(TexCoord, float(diffuseLayer))).rgb;
+#else
+    vec3 baseColor = material.diffuse;
+#endif
 
+#ifndef USE_LIGHTING
     // ===== LIGHTING OFF: show unlit/flat shading (very clear difference) =====
-    if (!lightingEnabled || numLights <= 0) {
-        // Option A: pure base color (flat)
-        vec3 result = baseColor;
+    // Option A: pure base color (flat)
+    vec3 result = baseColor;
 
-        // (Optional) tiny ambient to avoid looking "too dead"
-        // vec3 result = baseColor * 0.9 + material.ambient * 0.1;
-
-        // Keep gamma correction consistent with lighting-on path
-        result = pow(result, vec3(1.0 / 2.2));
-        FragColor = vec4(result, 1.0);
-        return;
-    }
+    // (Optional) tiny ambient to avoid looking "too dead"
+    // vec3 result = baseColor * 0.9 + material.ambient * 0.1;
+#else
+    // ===== LIGHTING ON: Blinn-Phong over the lights of this fragment's cluster =====
+    uvec2 range = texelFetch(clusterRanges, clusterIndex()).xy;
 
-    // ===== LIGHTING ON: normal Blinn-Phong =====
     vec3 result = vec3(0.0);
-    for (int i = 0; i < numLights && i < MAX_LIGHTS; ++i) {
-        result += calculateLight(lights[i], norm, viewDir, baseColor);
+    for (uint i = 0u; i < range.y; ++i) {
+        int lightIndex = int(texelFetch(clusterIndices, int(range.x + i)).r);
+        result += calculateLight(fetchLight(lightIndex), norm, viewDir, baseColor);
     }
+#endif
+
+#ifdef USE_WIREFRAME
+    // Distance to the closest edge in pixels (fwidth), antialiased over one pixel
+    vec3 edgeDistance = Barycentric / max(fwidth(Barycentric), vec3(1e-6));
+    float edge = min(min(edgeDistance.x, edgeDistance.y), edgeDistance.z);
+    result = mix(wireframeColor, result, smoothstep(wireframeWidth * 0.5 - 0.5, wireframeWidth * 0.5 + 0.5, edge));
+#endif
 
     // Gamma correction
     result = pow(result, vec3(1.0 / 2.2));
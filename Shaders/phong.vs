@@ -4,11 +4,26 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
 
+// USE_WIREFRAME: wireframe.gs sits between the stages and reads "v"-prefixed outputs
+#ifdef USE_WIREFRAME
+#define FragPos  vFragPos
+#define Normal   vNormal
+#define TexCoord vTexCoord
+#endif
+
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
 
 uniform mat4 model;
+uniform mat3 normalMatrix;   // transpose(inverse(mat3(model))), computed on the CPU
+
+// USE_INVERSE_NORMALS: reference path (--inverse-normals), normal matrix rebuilt per vertex.
+// objectModel is the object's matrix alone: with packed vertices "model" also holds the
+// position dequantization, whose non-uniform scale must not reach the normals
+#ifdef USE_INVERSE_NORMALS
+uniform mat4 objectModel;
+#endif
 uniform mat4 view;
 uniform mat4 projection;
 
@@ -17,7 +32,11 @@ void main() {
     FragPos = vec3(model * vec4(aPos, 1.0));
     
     // Transform normal (use normal matrix to handle non-uniform scaling)
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+#ifdef USE_INVERSE_NORMALS
+    Normal = mat3(transpose(inverse(objectModel))) * aNormal;
+#else
+    Normal = normalMatrix * aNormal;
+#endif
     
     // Pass texture coordinates
     TexCoord = aTexCoord;
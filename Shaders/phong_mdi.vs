@@ -0,0 +1,48 @@
+#version 430 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoord;
+layout (location = 3) in uint aDrawID;   // = baseInstance de la commande indirecte
+
+// USE_WIREFRAME: wireframe.gs sits between the stages and reads "v"-prefixed outputs
+#ifdef USE_WIREFRAME
+#define FragPos  vFragPos
+#define Normal   vNormal
+#define TexCoord vTexCoord
+#define DrawID   vDrawID
+#endif
+
+struct DrawData {
+    mat4 model;
+    mat4 normalMatrix;
+    vec4 ambient;
+    vec4 diffuse;    // w = texture array layer, < 0 when untextured
+    vec4 specular;   // w = shininess
+};
+
+layout (std430, binding = 0) readonly buffer DrawBuffer {
+    DrawData draws[];
+};
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+flat out uint DrawID;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main() {
+    DrawData d = draws[aDrawID];
+
+    FragPos = vec3(d.model * vec4(aPos, 1.0));
+
+    // Normal matrix precomputed on the CPU
+    Normal = mat3(d.normalMatrix) * aNormal;
+
+    TexCoord = aTexCoord;
+    DrawID = aDrawID;
+
+    gl_Position = projection * view * vec4(FragPos, 1.0);
+}
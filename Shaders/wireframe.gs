@@ -0,0 +1,41 @@
+#version 330 core
+
+// Single-pass wireframe (USE_WIREFRAME variants): passes the triangle through
+// and adds barycentric coordinates; the fragment shader darkens texels close
+// to an edge. The vertex shader writes "v"-prefixed outputs in these variants.
+// WITH_DRAW_ID: phong_mdi, forwards the per-draw index.
+
+layout (triangles) in;
+layout (triangle_strip, max_vertices = 3) out;
+
+in vec3 vFragPos[];
+in vec3 vNormal[];
+in vec2 vTexCoord[];
+#ifdef WITH_DRAW_ID
+flat in uint vDrawID[];
+#endif
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+#ifdef WITH_DRAW_ID
+flat out uint DrawID;
+#endif
+noperspective out vec3 Barycentric;   // screen-space interpolation: constant line width
+
+void main() {
+    const vec3 corners[3] = vec3[3](vec3(1.0, 0.0, 0.0), vec3(0.0, 1.0, 0.0), vec3(0.0, 0.0, 1.0));
+
+    for (int i = 0; i < 3; ++i) {
+        FragPos  = vFragPos[i];
+        Normal   = vNormal[i];
+        TexCoord = vTexCoord[i];
+#ifdef WITH_DRAW_ID
+        DrawID   = vDrawID[i];
+#endif
+        Barycentric = corners[i];
+        gl_Position = gl_in[i].gl_Position;
+        EmitVertex();
+    }
+    EndPrimitive();
+}
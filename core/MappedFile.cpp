@@ -0,0 +1,89 @@
+#include "MappedFile.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path)
+    : m_data(nullptr), m_size(0), m_fileHandle(INVALID_HANDLE_VALUE), m_mappingHandle(nullptr)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    m_fileHandle = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot stat file: " + path);
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+    if (m_size == 0) return;  // un fichier vide ne peut pas être projeté
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    m_mappingHandle = mapping;
+
+    m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mappingHandle) CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    if (m_fileHandle != INVALID_HANDLE_VALUE) CloseHandle(static_cast<HANDLE>(m_fileHandle));
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path)
+    : m_data(nullptr), m_size(0), m_fd(-1)
+{
+    m_fd = open(path.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    struct stat st;
+    if (fstat(m_fd, &st) != 0) {
+        close(m_fd);
+        throw std::runtime_error("Cannot stat file: " + path);
+    }
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size == 0) return;  // un fichier vide ne peut pas être projeté
+
+    void* mapped = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (mapped == MAP_FAILED) {
+        close(m_fd);
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+    // Lecture séquentielle : lecture anticipée agressive
+    madvise(mapped, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char*>(mapped);
+}
+
+MappedFile::~MappedFile() {
+    if (m_data) munmap(const_cast<char*>(m_data), m_size);
+    if (m_fd >= 0) close(m_fd);
+}
+
+#endif
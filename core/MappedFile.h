@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Fichier projeté en mémoire en lecture seule (mmap / MapViewOfFile)
+ *
+ * Évite la copie noyau -> buffer utilisateur des lectures classiques :
+ * les pages sont chargées à la demande et partagées avec le cache disque.
+ * Lève std::runtime_error si le fichier ne peut pas être ouvert.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    // Non-copiable (mapping unique)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const char* m_data;
+    size_t m_size;
+
+#ifdef _WIN32
+    void* m_fileHandle;
+    void* m_mappingHandle;
+#else
+    int m_fd;
+#endif
+};
@@ -1,18 +1,100 @@
 #include "Mesh.h"
+#include "MappedFile.h"
+#include "MeshOptimizer.h"
+#include "ObjLoader.h"
+#include <chrono>
+#include <stdexcept>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <glm/gtc/matrix_transform.hpp>
 
-Mesh::Mesh() : m_VAO(0), m_VBO(0), m_EBO(0) {}
+unsigned int Mesh::nextId() {
+    static std::atomic<unsigned int> counter{1};
+    return counter++;
+}
+
+static std::atomic<VertexFormat> s_defaultFormat{VertexFormat::FULL};
+
+void Mesh::setDefaultVertexFormat(VertexFormat format) {
+    s_defaultFormat = format;
+}
+
+VertexFormat Mesh::getDefaultVertexFormat() {
+    return s_defaultFormat;
+}
+
+// ===== COMPRESSION DES VERTICES =====
+
+// float -> half (IEEE 754 binaire16), arrondi au plus proche
+static uint16_t toHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (exponent >= 31) {
+        // Débordement / inf / NaN
+        bool isNaN = ((bits >> 23) & 0xFF) == 0xFF && mantissa != 0;
+        return static_cast<uint16_t>(sign | 0x7C00u | (isNaN ? 0x200u : 0u));
+    }
+    if (exponent <= 0) {
+        // Dénormalisé ou zéro
+        if (exponent < -10) return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000u;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        if ((mantissa >> (shift - 1)) & 1u) ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000u) ++half;  // l'arrondi peut propager dans l'exposant : voulu
+    return static_cast<uint16_t>(half);
+}
+
+// Normale [-1, 1]^3 -> GL_INT_2_10_10_10_REV signé normalisé (w = 0)
+static uint32_t packNormal(const glm::vec3& n) {
+    auto component = [](float v) {
+        v = std::min(std::max(v, -1.0f), 1.0f);
+        int32_t q = static_cast<int32_t>(std::lround(v * 511.0f));
+        return static_cast<uint32_t>(q) & 0x3FFu;
+    };
+    return component(n.x) | (component(n.y) << 10) | (component(n.z) << 20);
+}
+
+static uint16_t quantizeUnit(float v) {
+    v = std::min(std::max(v, 0.0f), 1.0f);
+    return static_cast<uint16_t>(std::lround(v * 65535.0f));
+}
+
+// ===== CONSTRUCTION =====
+
+Mesh::Mesh()
+    : m_id(nextId()), m_format(s_defaultFormat), m_VAO(0), m_VBO(0), m_EBO(0), m_indexType(GL_UNSIGNED_INT) {}
 
 Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices)
-    : m_vertices(vertices)
+    : Mesh(vertices, indices, s_defaultFormat)
+{}
+
+Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+           VertexFormat format)
+    : m_id(nextId())
+    , m_format(format)
+    , m_vertices(vertices)
     , m_indices(indices)
     , m_VAO(0), m_VBO(0), m_EBO(0)
+    , m_indexType(GL_UNSIGNED_INT)
 {
-    setupMesh();
+    // Bounds avant l'upload : nécessaires à la quantification des positions
     calculateBounds();
+    setupMesh();
 }
 
 Mesh::~Mesh() {
@@ -29,51 +111,140 @@ void Mesh::setupMesh() {
     
     glBindVertexArray(m_VAO);
     
-    // VBO (vertices)
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, 
-                 m_vertices.size() * sizeof(Vertex), 
-                 m_vertices.data(), 
-                 GL_STATIC_DRAW);
+    // VBO (vertices) + attributs
+    uploadVertices();
     
     // EBO (indices)
+    uploadIndices();
+    
+    glBindVertexArray(0);
+}
+
+void Mesh::uploadIndices() {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+
+    // Indices 16 bits dès que possible : moitié moins de bande passante à l'assemblage
+    bool fits16 = std::all_of(m_indices.begin(), m_indices.end(),
+                              [](unsigned int index) { return index <= 0xFFFFu; });
+
+    if (fits16) {
+        std::vector<uint16_t> shortIndices(m_indices.begin(), m_indices.end());
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                     shortIndices.size() * sizeof(uint16_t),
+                     shortIndices.data(),
+                     GL_STATIC_DRAW);
+        m_indexType = GL_UNSIGNED_SHORT;
+        return;
+    }
+
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, 
                  m_indices.size() * sizeof(unsigned int), 
                  m_indices.data(), 
                  GL_STATIC_DRAW);
+    m_indexType = GL_UNSIGNED_INT;
+}
+
+void Mesh::uploadVertices() {
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+
+    if (m_format == VertexFormat::PACKED) {
+        glm::vec3 extent = getQuantizationExtent();
+
+        std::vector<PackedVertex> packed(m_vertices.size());
+        for (size_t i = 0; i < m_vertices.size(); ++i) {
+            const Vertex& v = m_vertices[i];
+            glm::vec3 unit = (v.position - m_boundsMin) / extent;
+
+            PackedVertex& p = packed[i];
+            p.position[0]  = quantizeUnit(unit.x);
+            p.position[1]  = quantizeUnit(unit.y);
+            p.position[2]  = quantizeUnit(unit.z);
+            p.padding      = 0;
+            p.normal       = packNormal(v.normal);
+            p.texCoords[0] = toHalf(v.texCoords.x);
+            p.texCoords[1] = toHalf(v.texCoords.y);
+        }
+
+        glBufferData(GL_ARRAY_BUFFER,
+                     packed.size() * sizeof(PackedVertex),
+                     packed.data(),
+                     GL_STATIC_DRAW);
+
+        // Location 0: Position (normalisée sur les bounds, voir getPositionTransform)
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedVertex),
+                              (void*)offsetof(PackedVertex, position));
+
+        // Location 1: Normal (le shader lit un vec3, w ignoré)
+        glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(PackedVertex),
+                              (void*)offsetof(PackedVertex, normal));
+
+        // Location 2: TexCoords
+        glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex),
+                              (void*)offsetof(PackedVertex, texCoords));
+        return;
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, 
+                 m_vertices.size() * sizeof(Vertex), 
+                 m_vertices.data(), 
+                 GL_STATIC_DRAW);
     
     // Attributes layout
     // Location 0: Position
-    glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
     
     // Location 1: Normal
-    glEnableVertexAttribArray(1);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), 
                           (void*)offsetof(Vertex, normal));
     
     // Location 2: TexCoords
-    glEnableVertexAttribArray(2);
     glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), 
                           (void*)offsetof(Vertex, texCoords));
-    
+}
+
+void Mesh::setVertexFormat(VertexFormat format) {
+    if (format == m_format) return;
+    m_format = format;
+
+    if (!m_VAO) return;  // pas encore envoyé au GPU
+    glBindVertexArray(m_VAO);
+    uploadVertices();
     glBindVertexArray(0);
 }
 
+glm::vec3 Mesh::getQuantizationExtent() const {
+    // Axe plat (plan) : étendue 1 pour éviter la division par zéro
+    glm::vec3 extent = m_boundsMax - m_boundsMin;
+    for (int i = 0; i < 3; ++i) {
+        if (extent[i] <= 0.0f) extent[i] = 1.0f;
+    }
+    return extent;
+}
+
+glm::mat4 Mesh::getPositionTransform() const {
+    if (m_format != VertexFormat::PACKED) return glm::mat4(1.0f);
+
+    glm::mat4 transform = glm::translate(glm::mat4(1.0f), m_boundsMin);
+    return glm::scale(transform, getQuantizationExtent());
+}
+
 void Mesh::draw(unsigned int instanceCount) const {
     glBindVertexArray(m_VAO);
     
     if (instanceCount > 1) {
         glDrawElementsInstanced(GL_TRIANGLES, 
                                static_cast<GLsizei>(m_indices.size()), 
-                               GL_UNSIGNED_INT, 
+                               m_indexType, 
                                0, 
                                instanceCount);
     } else {
         glDrawElements(GL_TRIANGLES, 
                       static_cast<GLsizei>(m_indices.size()), 
-                      GL_UNSIGNED_INT, 
+                      m_indexType, 
                       0);
     }
     
@@ -81,19 +252,13 @@ void Mesh::draw(unsigned int instanceCount) const {
 }
 
 void Mesh::updateBuffers() {
-    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, 
-                 m_vertices.size() * sizeof(Vertex), 
-                 m_vertices.data(), 
-                 GL_STATIC_DRAW);
-    
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, 
-                 m_indices.size() * sizeof(unsigned int), 
-                 m_indices.data(), 
-                 GL_STATIC_DRAW);
-    
+    // Bounds d'abord : la quantification PACKED en dépend
     calculateBounds();
+
+    glBindVertexArray(m_VAO);
+    uploadVertices();
+    uploadIndices();
+    glBindVertexArray(0);
 }
 
 void Mesh::calculateNormals() {
@@ -141,6 +306,19 @@ void Mesh::calculateBounds() {
 
 // ===== GÉNÉRATEURS PROCÉDURAUX =====
 
+// Passe d'optimisation commune (cache, overdraw, fetch) avec rapport ACMR
+static void optimizeGeometry(const std::string& label,
+                             std::vector<Vertex>& vertices,
+                             std::vector<unsigned int>& indices) {
+    MeshOptimizer::Stats stats = MeshOptimizer::optimize(vertices, indices);
+    std::cout << "[MeshOptimizer] " << label << ": ACMR " << stats.acmrBefore
+              << " -> " << stats.acmrAfter << " (" << indices.size() / 3 << " triangles";
+    if (stats.verticesAfter != stats.verticesBefore) {
+        std::cout << ", " << stats.verticesBefore - stats.verticesAfter << " unused vertices removed";
+    }
+    std::cout << ")" << std::endl;
+}
+
 Mesh Mesh::createCube(float size) {
     float s = size * 0.5f;
     
@@ -191,6 +369,7 @@ Mesh Mesh::createCube(float size) {
         });
     }
     
+    optimizeGeometry("cube", vertices, indices);
     return Mesh(vertices, indices);
 }
 
@@ -235,5 +414,37 @@ Mesh Mesh::createSphere(float radius, int segments) {
         }
     }
     
+    optimizeGeometry("sphere " + std::to_string(segments), vertices, indices);
+    return Mesh(vertices, indices);
+}
+
+// ===== IMPORT =====
+
+Mesh Mesh::loadFromOBJ(const std::string& path) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+
+    const std::string cachePath = ObjLoader::getCachePath(path);
+    bool fromCache = ObjLoader::readCache(cachePath, path, vertices, indices);
+
+    if (!fromCache) {
+        MappedFile file(path);
+        if (!ObjLoader::parse(file.data(), file.size(), vertices, indices)) {
+            throw std::runtime_error("OBJ contains no faces: " + path);
+        }
+        // Optimisé une fois, à la construction du cache
+        optimizeGeometry(path, vertices, indices);
+        if (!ObjLoader::writeCache(cachePath, path, vertices, indices)) {
+            std::cerr << "[Mesh] Warning: could not write cache " << cachePath << std::endl;
+        }
+    }
+
+    float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[Mesh] " << path << ": " << vertices.size() << " vertices, "
+              << indices.size() / 3 << " triangles in " << ms << " ms"
+              << (fromCache ? " (cache)" : "") << std::endl;
+
     return Mesh(vertices, indices);
-}
\ No newline at end of file
+}
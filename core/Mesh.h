@@ -2,6 +2,7 @@
 
 #include <glad/gl.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -20,6 +21,30 @@ struct Vertex {
         : position(pos), normal(norm), texCoords(uv) {}
 };
 
+/**
+ * @brief Format des vertices côté GPU
+ * - FULL   : Vertex tel quel (32 octets, float)
+ * - PACKED : PackedVertex (16 octets) — positions normalisées 16 bits relatives
+ *            aux bounds, normales GL_INT_2_10_10_10_REV, UV en half-float
+ */
+enum class VertexFormat {
+    FULL,
+    PACKED
+};
+
+/**
+ * @struct PackedVertex
+ * @brief Vertex compressé (VertexFormat::PACKED)
+ * La position décompressée vaut boundsMin + p * (boundsMax - boundsMin),
+ * voir Mesh::getPositionTransform().
+ */
+struct PackedVertex {
+    uint16_t position[3];   // GL_UNSIGNED_SHORT normalisé [0, 1] sur les bounds
+    uint16_t padding;       // alignement 4 octets de l'attribut suivant
+    uint32_t normal;        // GL_INT_2_10_10_10_REV normalisé
+    uint16_t texCoords[2];  // GL_HALF_FLOAT
+};
+
 /**
  * @class Mesh
  * @brief Représentation géométrique optimisée GPU
@@ -39,6 +64,13 @@ public:
      */
     Mesh(const std::vector<Vertex>& vertices, 
          const std::vector<unsigned int>& indices);
+
+    /**
+     * @brief Constructeur avec format GPU explicite
+     */
+    Mesh(const std::vector<Vertex>& vertices,
+         const std::vector<unsigned int>& indices,
+         VertexFormat format);
     
     /**
      * @brief Destructeur - Libère VAO/VBO/EBO
@@ -60,6 +92,39 @@ public:
      */
     void updateBuffers();
 
+    /**
+     * @brief Change le format GPU (ré-upload du VBO, les données CPU restent en float)
+     */
+    void setVertexFormat(VertexFormat format);
+    VertexFormat getVertexFormat() const { return m_format; }
+
+    /**
+     * @brief Format utilisé par les constructeurs sans format explicite
+     */
+    static void setDefaultVertexFormat(VertexFormat format);
+    static VertexFormat getDefaultVertexFormat();
+
+    /**
+     * @brief Taille d'un vertex côté GPU (octets)
+     */
+    size_t getVertexStride() const {
+        return m_format == VertexFormat::PACKED ? sizeof(PackedVertex) : sizeof(Vertex);
+    }
+
+    /**
+     * @brief Matrice à appliquer avant la matrice Model pour décompresser les positions
+     * Identité en FULL ; translate(boundsMin) * scale(étendue) en PACKED.
+     * Les normales ne sont pas concernées (la matrice des normales reste celle du Model).
+     */
+    glm::mat4 getPositionTransform() const;
+
+    /**
+     * @brief Type des indices côté GPU : GL_UNSIGNED_SHORT si tous les indices
+     * tiennent sur 16 bits, GL_UNSIGNED_INT sinon (les indices CPU restent 32 bits)
+     */
+    GLenum getIndexType() const { return m_indexType; }
+    size_t getIndexSize() const { return m_indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(uint32_t); }
+
     /**
      * @brief Calcule les normales automatiquement
      */
@@ -88,7 +153,14 @@ public:
     
     std::vector<Vertex>& getVertices() { return m_vertices; }
     std::vector<unsigned int>& getIndices() { return m_indices; }
+    const std::vector<Vertex>& getVertices() const { return m_vertices; }
+    const std::vector<unsigned int>& getIndices() const { return m_indices; }
     
+    /**
+     * @brief Identifiant unique (jamais réutilisé, contrairement à l'adresse)
+     */
+    unsigned int getId() const { return m_id; }
+
     glm::vec3 getBoundsMin() const { return m_boundsMin; }
     glm::vec3 getBoundsMax() const { return m_boundsMax; }
     glm::vec3 getBoundsCenter() const { return (m_boundsMin + m_boundsMax) * 0.5f; }
@@ -100,11 +172,28 @@ private:
      */
     void setupMesh();
 
+    /**
+     * @brief Envoie les vertices au VBO et configure les attributs selon m_format
+     */
+    void uploadVertices();
+
+    /**
+     * @brief Envoie les indices à l'EBO (16 bits si possible)
+     */
+    void uploadIndices();
+
+    glm::vec3 getQuantizationExtent() const;
+
+    static unsigned int nextId();
+
+    unsigned int m_id;
+    VertexFormat m_format;
     std::vector<Vertex> m_vertices;
     std::vector<unsigned int> m_indices;
     
     // OpenGL handles
     GLuint m_VAO, m_VBO, m_EBO;
+    GLenum m_indexType;
     
     // Bounding volume
     glm::vec3 m_boundsMin;
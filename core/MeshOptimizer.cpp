@@ -0,0 +1,289 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// ===== MESURE =====
+
+float MeshOptimizer::computeACMR(const std::vector<unsigned int>& indices, size_t vertexCount,
+                                 unsigned int cacheSize) {
+    if (indices.size() < 3) return 0.0f;
+
+    // FIFO simulé par horodatage : un vertex est en cache s'il a été chargé
+    // il y a moins de cacheSize chargements
+    std::vector<uint32_t> loadedAt(vertexCount, 0);
+    uint32_t timestamp = cacheSize + 1;
+    size_t misses = 0;
+
+    for (unsigned int index : indices) {
+        if (timestamp - loadedAt[index] > cacheSize) {
+            loadedAt[index] = timestamp++;
+            ++misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+// ===== PASSE 1 : CACHE POST-TRANSFORM (FORSYTH) =====
+
+namespace {
+
+constexpr int FORSYTH_CACHE_SIZE = 32;
+constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float CACHE_DECAY_POWER = 1.5f;
+constexpr float VALENCE_BOOST_SCALE = 2.0f;
+constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+float vertexScore(int cachePosition, unsigned int remainingTriangles) {
+    if (remainingTriangles == 0) return -1.0f;  // plus aucun triangle : inutile de le garder
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // Vertices du dernier triangle : score fixe, sinon on favoriserait
+            // les bandes au détriment des éventails
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            const float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+        }
+    }
+    // Bonus aux vertices presque terminés : évite les triangles isolés en fin de parcours
+    score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+    return score;
+}
+
+} // namespace
+
+void MeshOptimizer::optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2 || vertexCount == 0) return;
+
+    // Adjacence vertex -> triangles (CSR)
+    std::vector<unsigned int> remaining(vertexCount, 0);
+    for (unsigned int index : indices) ++remaining[index];
+
+    std::vector<unsigned int> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) offsets[v + 1] = offsets[v] + remaining[v];
+
+    std::vector<unsigned int> adjacency(indices.size());
+    {
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) adjacency[fill[indices[t * 3 + k]]++] = static_cast<unsigned int>(t);
+        }
+    }
+
+    std::vector<float> vScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) vScore[v] = vertexScore(-1, remaining[v]);
+
+    auto triangleScore = [&](size_t t) {
+        return vScore[indices[t * 3]] + vScore[indices[t * 3 + 1]] + vScore[indices[t * 3 + 2]];
+    };
+
+    // Premier triangle : meilleur score global
+    size_t best = 0;
+    for (size_t t = 1; t < triangleCount; ++t) {
+        if (triangleScore(t) > triangleScore(best)) best = t;
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+
+    std::vector<unsigned int> output;
+    output.reserve(indices.size());
+
+    // Cache LRU (+3 places pour les vertices du triangle entrant avant éviction)
+    std::vector<unsigned int> cache, nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    size_t cursor = 0;  // reprise linéaire quand le cache ne propose plus rien
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        emitted[best] = true;
+        const unsigned int* tri = &indices[best * 3];
+        output.insert(output.end(), tri, tri + 3);
+
+        // Retirer le triangle de l'adjacence de ses vertices
+        for (int k = 0; k < 3; ++k) {
+            unsigned int v = tri[k];
+            unsigned int* begin = &adjacency[offsets[v]];
+            unsigned int* end = begin + remaining[v];
+            std::iter_swap(std::find(begin, end, static_cast<unsigned int>(best)), end - 1);
+            --remaining[v];
+        }
+
+        // Mise à jour LRU : le triangle courant en tête
+        nextCache.assign(tri, tri + 3);
+        for (unsigned int v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) nextCache.push_back(v);
+        }
+        std::swap(cache, nextCache);
+
+        // Rescorer les vertices du cache (et ceux qui en sortent)
+        for (size_t i = 0; i < cache.size(); ++i) {
+            unsigned int v = cache[i];
+            int position = i < static_cast<size_t>(FORSYTH_CACHE_SIZE) ? static_cast<int>(i) : -1;
+            vScore[v] = vertexScore(position, remaining[v]);
+        }
+        if (cache.size() > static_cast<size_t>(FORSYTH_CACHE_SIZE)) cache.resize(FORSYTH_CACHE_SIZE);
+
+        // Rescorer les triangles touchés et choisir le suivant parmi eux
+        float bestScore = -1.0f;
+        size_t candidate = triangleCount;
+        for (unsigned int v : cache) {
+            for (unsigned int a = offsets[v]; a < offsets[v] + remaining[v]; ++a) {
+                unsigned int t = adjacency[a];
+                float score = triangleScore(t);
+                if (score > bestScore) {
+                    bestScore = score;
+                    candidate = t;
+                }
+            }
+        }
+
+        if (candidate == triangleCount) {
+            // Impasse : prochain triangle non émis dans l'ordre d'origine
+            while (cursor < triangleCount && emitted[cursor]) ++cursor;
+            if (cursor == triangleCount) break;
+            candidate = cursor;
+        }
+        best = candidate;
+    }
+
+    indices.swap(output);
+}
+
+// ===== PASSE 2 : OVERDRAW =====
+
+void MeshOptimizer::optimizeOverdraw(std::vector<unsigned int>& indices,
+                                     const std::vector<Vertex>& vertices,
+                                     float threshold) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2 || vertices.empty()) return;
+
+    const float acmrBefore = computeACMR(indices, vertices.size());
+
+    // Clusters : coupure là où les 3 vertices du triangle ratent le cache,
+    // c.-à-d. là où réordonner ne coûte (presque) rien au cache
+    std::vector<size_t> clusterStarts;
+    {
+        std::vector<uint32_t> loadedAt(vertices.size(), 0);
+        uint32_t timestamp = CACHE_SIZE + 1;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            int misses = 0;
+            for (int k = 0; k < 3; ++k) {
+                unsigned int v = indices[t * 3 + k];
+                if (timestamp - loadedAt[v] > CACHE_SIZE) {
+                    loadedAt[v] = timestamp++;
+                    ++misses;
+                }
+            }
+            if (t == 0 || misses == 3) clusterStarts.push_back(t);
+        }
+    }
+    if (clusterStarts.size() < 2) return;
+    clusterStarts.push_back(triangleCount);
+
+    // Centre du mesh pondéré par l'aire
+    glm::vec3 meshCenter(0.0f);
+    float meshArea = 0.0f;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3& a = vertices[indices[t * 3]].position;
+        const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+        const glm::vec3& c = vertices[indices[t * 3 + 2]].position;
+        float area = glm::length(glm::cross(b - a, c - a));
+        meshCenter += (a + b + c) * (area / 3.0f);
+        meshArea += area;
+    }
+    if (meshArea <= 0.0f) return;
+    meshCenter /= meshArea;
+
+    // Tri des clusters : les plus "extérieurs" (normale alignée avec la
+    // direction depuis le centre) d'abord, ils occultent les autres
+    struct Cluster {
+        size_t begin, end;
+        float key;
+    };
+    std::vector<Cluster> clusters;
+    clusters.reserve(clusterStarts.size() - 1);
+
+    for (size_t c = 0; c + 1 < clusterStarts.size(); ++c) {
+        glm::vec3 center(0.0f), normal(0.0f);
+        float area = 0.0f;
+        for (size_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t) {
+            const glm::vec3& a = vertices[indices[t * 3]].position;
+            const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3& p = vertices[indices[t * 3 + 2]].position;
+            glm::vec3 n = glm::cross(b - a, p - a);  // longueur = 2 * aire
+            float triArea = glm::length(n);
+            center += (a + b + p) * (triArea / 3.0f);
+            normal += n;
+            area += triArea;
+        }
+        float key = 0.0f;
+        if (area > 0.0f) {
+            center /= area;
+            float normalLength = glm::length(normal);
+            if (normalLength > 0.0f) key = glm::dot(center - meshCenter, normal / normalLength);
+        }
+        clusters.push_back({ clusterStarts[c], clusterStarts[c + 1], key });
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.key > b.key; });
+
+    std::vector<unsigned int> sorted;
+    sorted.reserve(indices.size());
+    for (const Cluster& cluster : clusters) {
+        sorted.insert(sorted.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+    }
+
+    // Garde-fou : ne pas payer l'overdraw par trop de vertex shading
+    if (computeACMR(sorted, vertices.size()) <= acmrBefore * threshold) {
+        indices.swap(sorted);
+    }
+}
+
+// ===== PASSE 3 : FETCH =====
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    const unsigned int UNUSED = ~0u;
+    std::vector<unsigned int> remap(vertices.size(), UNUSED);
+
+    std::vector<Vertex> reordered;
+    reordered.reserve(vertices.size());
+
+    for (unsigned int& index : indices) {
+        if (remap[index] == UNUSED) {
+            remap[index] = static_cast<unsigned int>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    vertices.swap(reordered);
+}
+
+// ===== ENCHAÎNEMENT =====
+
+MeshOptimizer::Stats MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    Stats stats;
+    stats.verticesBefore = vertices.size();
+    stats.acmrBefore = computeACMR(indices, vertices.size());
+
+    if (indices.size() % 3 == 0) {
+        // Petits meshes déjà tenus en entier par le cache : garder l'ordre d'origine s'il est meilleur
+        std::vector<unsigned int> original = indices;
+        optimizeVertexCache(indices, vertices.size());
+        if (computeACMR(indices, vertices.size()) > stats.acmrBefore) {
+            indices.swap(original);
+        }
+        optimizeOverdraw(indices, vertices);
+        optimizeVertexFetch(vertices, indices);
+    }
+
+    stats.verticesAfter = vertices.size();
+    stats.acmrAfter = computeACMR(indices, vertices.size());
+    return stats;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Mesh.h"
+#include <vector>
+
+/**
+ * @class MeshOptimizer
+ * @brief Réordonnancement des indices/vertices pour le GPU
+ *
+ * Trois passes, à lancer dans cet ordre (optimize() les enchaîne) :
+ * 1. Cache post-transform : ordre des triangles de Forsyth ("Linear-Speed
+ *    Vertex Cache Optimisation"), score LRU par vertex
+ * 2. Overdraw : découpage en clusters aux ruptures de cache puis tri des
+ *    clusters de l'extérieur vers l'intérieur (Sander et al.), refusé si
+ *    l'ACMR se dégrade au-delà du seuil
+ * 3. Fetch : vertices renumérotés dans l'ordre de première utilisation
+ *    (les vertices non référencés sont supprimés)
+ *
+ * Les passes 1 et 2 sont annulées si elles dégradent l'ACMR mesuré.
+ *
+ * ACMR = vertices transformés / triangles, mesuré sur un cache FIFO
+ * (~0.5 à 0.7 pour une grille bien ordonnée, 3.0 = aucun partage).
+ */
+class MeshOptimizer {
+public:
+    struct Stats {
+        float acmrBefore = 0.0f;
+        float acmrAfter = 0.0f;
+        size_t verticesBefore = 0;
+        size_t verticesAfter = 0;
+    };
+
+    static constexpr unsigned int CACHE_SIZE = 16;         // FIFO de mesure (ACMR)
+    static constexpr float OVERDRAW_THRESHOLD = 1.05f;     // dégradation ACMR tolérée par la passe 2
+
+    /**
+     * @brief Enchaîne les trois passes (modifie vertices et indices en place)
+     */
+    static Stats optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+    static void optimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount);
+
+    static void optimizeOverdraw(std::vector<unsigned int>& indices,
+                                 const std::vector<Vertex>& vertices,
+                                 float threshold = OVERDRAW_THRESHOLD);
+
+    static void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+    /**
+     * @brief Average Cache Miss Ratio sur un cache FIFO de cacheSize entrées
+     */
+    static float computeACMR(const std::vector<unsigned int>& indices, size_t vertexCount,
+                             unsigned int cacheSize = CACHE_SIZE);
+};
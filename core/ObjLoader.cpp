@@ -0,0 +1,424 @@
+#include "ObjLoader.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+// ===== ANALYSE NUMÉRIQUE =====
+
+namespace {
+
+constexpr size_t MIN_CHUNK_BYTES = 256 * 1024;
+constexpr int NO_INDEX = INT_MIN;
+
+// Sommet de face : indices v/vt/vn (0-based), relatifs au bloc si bit correspondant
+struct Corner {
+    int v, vt, vn;
+    unsigned char relative;   // bit 0 = v, bit 1 = vt, bit 2 = vn
+
+    bool operator==(const Corner& o) const { return v == o.v && vt == o.vt && vn == o.vn; }
+};
+
+struct CornerHash {
+    size_t operator()(const Corner& c) const {
+        uint64_t h = static_cast<uint32_t>(c.v) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<uint32_t>(c.vt) * 0xC2B2AE3D27D4EB4Full;
+        h ^= static_cast<uint32_t>(c.vn) * 0x165667B19E3779F9ull;
+        h ^= h >> 29;   // bits hauts -> bits bas (le masque garde les bits bas)
+        return static_cast<size_t>(h);
+    }
+};
+
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<Corner> corners;     // 3 par triangle
+};
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t'; }
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && isBlank(*p)) ++p;
+    return p;
+}
+
+inline const char* skipLine(const char* p, const char* end) {
+    while (p < end && *p != '\n') ++p;
+    return p < end ? p + 1 : end;
+}
+
+const char* parseFloat(const char* p, const char* end, float& out) {
+    p = skipBlanks(p, end);
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    // Mantisse entière sur 64 bits (19 chiffres significatifs), exposant décimal à part
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+
+    while (p < end && isDigit(*p)) {
+        if (digits < 19) { mantissa = mantissa * 10 + (*p - '0'); ++digits; }
+        else ++exponent;
+        ++p;
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && isDigit(*p)) {
+            if (digits < 19) { mantissa = mantissa * 10 + (*p - '0'); ++digits; --exponent; }
+            ++p;
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool expNegative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            expNegative = (*p == '-');
+            ++p;
+        }
+        int e = 0;
+        while (p < end && isDigit(*p)) {
+            if (e < 10000) e = e * 10 + (*p - '0');
+            ++p;
+        }
+        exponent += expNegative ? -e : e;
+    }
+
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    double value = static_cast<double>(mantissa);
+    while (exponent > 22) { value *= 1e22; exponent -= 22; }
+    while (exponent < -22) { value /= 1e22; exponent += 22; }
+    value = (exponent >= 0) ? value * powers[exponent] : value / powers[-exponent];
+
+    out = static_cast<float>(negative ? -value : value);
+    return p;
+}
+
+// Retourne false si aucun chiffre n'a été lu
+const char* parseInt(const char* p, const char* end, int& out, bool& ok) {
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    ok = false;
+    int value = 0;
+    while (p < end && isDigit(*p)) {
+        value = value * 10 + (*p - '0');
+        ok = true;
+        ++p;
+    }
+    out = negative ? -value : value;
+    return p;
+}
+
+// OBJ : 1-based, négatif = relatif au dernier élément défini
+inline int resolveIndex(int raw, size_t localCount, unsigned char bit, unsigned char& relative) {
+    if (raw > 0) return raw - 1;
+    relative |= bit;
+    return static_cast<int>(localCount) + raw;  // peut être < 0 : élément d'un bloc précédent
+}
+
+void parseChunk(Chunk& chunk) {
+    const char* p = chunk.begin;
+    const char* end = chunk.end;
+    std::vector<Corner> polygon;
+
+    while (p < end) {
+        p = skipBlanks(p, end);
+        if (p >= end) break;
+
+        if (p[0] == 'v' && p + 1 < end && isBlank(p[1])) {
+            glm::vec3 v;
+            p = parseFloat(p + 2, end, v.x);
+            p = parseFloat(p, end, v.y);
+            p = parseFloat(p, end, v.z);
+            chunk.positions.push_back(v);
+        } else if (p[0] == 'v' && p + 2 < end && p[1] == 't' && isBlank(p[2])) {
+            glm::vec2 t;
+            p = parseFloat(p + 3, end, t.x);
+            p = parseFloat(p, end, t.y);
+            chunk.texCoords.push_back(t);
+        } else if (p[0] == 'v' && p + 2 < end && p[1] == 'n' && isBlank(p[2])) {
+            glm::vec3 n;
+            p = parseFloat(p + 3, end, n.x);
+            p = parseFloat(p, end, n.y);
+            p = parseFloat(p, end, n.z);
+            chunk.normals.push_back(n);
+        } else if (p[0] == 'f' && p + 1 < end && isBlank(p[1])) {
+            polygon.clear();
+            p += 2;
+
+            for (;;) {
+                p = skipBlanks(p, end);
+                if (p >= end || *p == '\n' || *p == '\r' || *p == '#') break;
+
+                Corner corner{ NO_INDEX, NO_INDEX, NO_INDEX, 0 };
+                int raw;
+                bool ok;
+
+                p = parseInt(p, end, raw, ok);
+                if (!ok) break;  // ligne malformée : on garde ce qui précède
+                corner.v = resolveIndex(raw, chunk.positions.size(), 1, corner.relative);
+
+                if (p < end && *p == '/') {
+                    ++p;
+                    p = parseInt(p, end, raw, ok);
+                    if (ok) corner.vt = resolveIndex(raw, chunk.texCoords.size(), 2, corner.relative);
+
+                    if (p < end && *p == '/') {
+                        ++p;
+                        p = parseInt(p, end, raw, ok);
+                        if (ok) corner.vn = resolveIndex(raw, chunk.normals.size(), 4, corner.relative);
+                    }
+                }
+                polygon.push_back(corner);
+            }
+
+            // Triangulation en éventail (polygones convexes)
+            for (size_t i = 2; i < polygon.size(); ++i) {
+                chunk.corners.push_back(polygon[0]);
+                chunk.corners.push_back(polygon[i - 1]);
+                chunk.corners.push_back(polygon[i]);
+            }
+        }
+
+        p = skipLine(p, end);
+    }
+}
+
+} // namespace
+
+// ===== OBJ LOADER =====
+
+bool ObjLoader::parse(const char* data, size_t size,
+                      std::vector<Vertex>& outVertices,
+                      std::vector<unsigned int>& outIndices,
+                      unsigned int threadCount) {
+    outVertices.clear();
+    outIndices.clear();
+    if (!data || size == 0) return false;
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t chunkCount = std::max<size_t>(1, std::min<size_t>(threadCount, size / MIN_CHUNK_BYTES));
+
+    // Découpage sur des fins de ligne
+    std::vector<Chunk> chunks(chunkCount);
+    const char* end = data + size;
+    const char* cursor = data;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        chunks[i].begin = cursor;
+        if (i + 1 == chunkCount) {
+            cursor = end;
+        } else {
+            const char* split = std::max(cursor, data + size * (i + 1) / chunkCount);
+            cursor = skipLine(split, end);
+        }
+        chunks[i].end = cursor;
+    }
+
+    if (chunkCount == 1) {
+        parseChunk(chunks[0]);
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(chunkCount - 1);
+        for (size_t i = 1; i < chunkCount; ++i) {
+            workers.emplace_back(parseChunk, std::ref(chunks[i]));
+        }
+        parseChunk(chunks[0]);
+        for (auto& worker : workers) worker.join();
+    }
+
+    // Concaténation des attributs + rebasage des indices relatifs
+    std::vector<glm::vec3> positions, normals;
+    std::vector<glm::vec2> texCoords;
+    size_t cornerCount = 0;
+    for (const auto& chunk : chunks) cornerCount += chunk.corners.size();
+
+    std::vector<Corner> corners;
+    corners.reserve(cornerCount);
+
+    for (auto& chunk : chunks) {
+        const int vOffset = static_cast<int>(positions.size());
+        const int tOffset = static_cast<int>(texCoords.size());
+        const int nOffset = static_cast<int>(normals.size());
+
+        for (Corner c : chunk.corners) {
+            if (c.relative & 1) c.v += vOffset;
+            if (c.relative & 2) c.vt += tOffset;
+            if (c.relative & 4) c.vn += nOffset;
+            c.relative = 0;
+            corners.push_back(c);
+        }
+
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+        chunk = Chunk();  // libère la mémoire du bloc au fur et à mesure
+    }
+
+    // Déduplication (ordre d'apparition conservé) : table de hachage à adressage ouvert,
+    // chaque case contient l'index du sommet unique + 1 (0 = vide)
+    size_t tableSize = 16;
+    while (tableSize < corners.size() * 2) tableSize <<= 1;
+    const size_t mask = tableSize - 1;
+    std::vector<unsigned int> table(tableSize, 0);
+    std::vector<Corner> uniqueCorners;
+    uniqueCorners.reserve(corners.size() / 2);
+
+    outIndices.reserve(corners.size());
+    bool missingNormals = false;
+    CornerHash hasher;
+
+    for (Corner& c : corners) {
+        if (c.v < 0 || c.v >= static_cast<int>(positions.size())) {
+            throw std::runtime_error("OBJ: vertex index out of range");
+        }
+        if (c.vt != NO_INDEX && (c.vt < 0 || c.vt >= static_cast<int>(texCoords.size()))) c.vt = NO_INDEX;
+        if (c.vn != NO_INDEX && (c.vn < 0 || c.vn >= static_cast<int>(normals.size()))) c.vn = NO_INDEX;
+
+        size_t slot = hasher(c) & mask;
+        while (table[slot] != 0 && !(uniqueCorners[table[slot] - 1] == c)) {
+            slot = (slot + 1) & mask;
+        }
+
+        if (table[slot] == 0) {
+            table[slot] = static_cast<unsigned int>(uniqueCorners.size() + 1);
+            uniqueCorners.push_back(c);
+
+            Vertex vertex(positions[c.v]);
+            vertex.texCoords = (c.vt != NO_INDEX) ? texCoords[c.vt] : glm::vec2(0.0f);
+            if (c.vn != NO_INDEX) {
+                vertex.normal = normals[c.vn];
+            } else {
+                vertex.normal = glm::vec3(0.0f);
+                missingNormals = true;
+            }
+            outVertices.push_back(vertex);
+        }
+        outIndices.push_back(table[slot] - 1);
+    }
+
+    // Normales lissées pour les sommets qui n'en ont pas
+    if (missingNormals) {
+        std::vector<glm::vec3> accum(outVertices.size(), glm::vec3(0.0f));
+        for (size_t i = 0; i + 2 < outIndices.size(); i += 3) {
+            const glm::vec3& a = outVertices[outIndices[i]].position;
+            const glm::vec3& b = outVertices[outIndices[i + 1]].position;
+            const glm::vec3& c = outVertices[outIndices[i + 2]].position;
+            glm::vec3 n = glm::cross(b - a, c - a);   // pondéré par l'aire
+            accum[outIndices[i]] += n;
+            accum[outIndices[i + 1]] += n;
+            accum[outIndices[i + 2]] += n;
+        }
+        for (size_t i = 0; i < outVertices.size(); ++i) {
+            if (outVertices[i].normal == glm::vec3(0.0f) && glm::length(accum[i]) > 0.0f) {
+                outVertices[i].normal = glm::normalize(accum[i]);
+            }
+        }
+    }
+
+    return !outIndices.empty();
+}
+
+// ===== CACHE BINAIRE =====
+
+bool ObjLoader::getSourceStamp(const std::string& sourcePath, uint64_t& outSize, int64_t& outTime) {
+    std::error_code ec;
+    outSize = std::filesystem::file_size(sourcePath, ec);
+    if (ec) return false;
+    auto time = std::filesystem::last_write_time(sourcePath, ec);
+    if (ec) return false;
+    outTime = static_cast<int64_t>(time.time_since_epoch().count());
+    return true;
+}
+
+bool ObjLoader::readCache(const std::string& cachePath, const std::string& sourcePath,
+                          std::vector<Vertex>& outVertices,
+                          std::vector<unsigned int>& outIndices) {
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    if (!getSourceStamp(sourcePath, sourceSize, sourceTime)) return false;
+
+    std::ifstream file(cachePath, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+
+    std::streamsize fileSize = file.tellg();
+    if (fileSize < static_cast<std::streamsize>(sizeof(CacheHeader))) return false;
+    file.seekg(0);
+
+    // Une seule lecture pour tout le fichier
+    std::vector<char> buffer(static_cast<size_t>(fileSize));
+    if (!file.read(buffer.data(), fileSize)) return false;
+
+    CacheHeader header;
+    std::memcpy(&header, buffer.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, "MCMESH\0\0", 8) != 0 ||
+        header.version != CACHE_VERSION ||
+        header.vertexSize != sizeof(Vertex) ||
+        header.sourceSize != sourceSize ||
+        header.sourceTime != sourceTime) {
+        return false;
+    }
+
+    size_t vertexBytes = static_cast<size_t>(header.vertexCount) * sizeof(Vertex);
+    size_t indexBytes = static_cast<size_t>(header.indexCount) * sizeof(unsigned int);
+    if (buffer.size() != sizeof(CacheHeader) + vertexBytes + indexBytes) return false;
+
+    outVertices.resize(header.vertexCount);
+    outIndices.resize(header.indexCount);
+    std::memcpy(outVertices.data(), buffer.data() + sizeof(CacheHeader), vertexBytes);
+    std::memcpy(outIndices.data(), buffer.data() + sizeof(CacheHeader) + vertexBytes, indexBytes);
+    return true;
+}
+
+bool ObjLoader::writeCache(const std::string& cachePath, const std::string& sourcePath,
+                           const std::vector<Vertex>& vertices,
+                           const std::vector<unsigned int>& indices) {
+    CacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "MCMESH\0\0", 8);
+    header.version = CACHE_VERSION;
+    header.vertexSize = sizeof(Vertex);
+    header.vertexCount = static_cast<uint32_t>(vertices.size());
+    header.indexCount = static_cast<uint32_t>(indices.size());
+    if (!getSourceStamp(sourcePath, header.sourceSize, header.sourceTime)) return false;
+
+    // Écriture dans un fichier temporaire puis renommage : jamais de cache à moitié écrit
+    std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(Vertex));
+        file.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(unsigned int));
+        if (!file) return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Mesh.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ObjLoader
+ * @brief Chargement rapide de fichiers Wavefront OBJ + cache binaire
+ *
+ * - Fichier projeté en mémoire (MappedFile), découpé en blocs alignés sur
+ *   les fins de ligne et analysés en parallèle (un thread par bloc)
+ * - Analyse numérique écrite à la main (pas de stringstream/strtod)
+ * - Déduplication des sommets (position/uv/normale) par table de hachage
+ * - Cache ".meshcache" à côté du fichier source : en-tête + sommets + indices,
+ *   relu en une seule lecture tant que la taille et la date du source ne changent pas
+ *   (géométrie déjà optimisée par MeshOptimizer, voir Mesh::loadFromOBJ)
+ *
+ * Supporte v, vt, vn, f (polygones triangulés en éventail, indices négatifs).
+ * Les autres directives (o, g, s, usemtl, mtllib...) sont ignorées.
+ */
+class ObjLoader {
+public:
+    /**
+     * @brief Analyse un OBJ depuis un buffer mémoire
+     * @param threadCount 0 = nombre de cœurs disponibles
+     * @return false si aucun triangle n'a été trouvé
+     */
+    static bool parse(const char* data, size_t size,
+                      std::vector<Vertex>& outVertices,
+                      std::vector<unsigned int>& outIndices,
+                      unsigned int threadCount = 0);
+
+    /**
+     * @brief Charge le cache si valide pour ce fichier source
+     * @return false si absent, obsolète ou corrompu
+     */
+    static bool readCache(const std::string& cachePath, const std::string& sourcePath,
+                          std::vector<Vertex>& outVertices,
+                          std::vector<unsigned int>& outIndices);
+
+    /**
+     * @brief Écrit le cache (échec non bloquant : retourne false)
+     */
+    static bool writeCache(const std::string& cachePath, const std::string& sourcePath,
+                           const std::vector<Vertex>& vertices,
+                           const std::vector<unsigned int>& indices);
+
+    static std::string getCachePath(const std::string& sourcePath) { return sourcePath + ".meshcache"; }
+
+private:
+    // En-tête du cache, versionné (changer CACHE_VERSION si Vertex change)
+    struct CacheHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t vertexSize;
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        uint32_t vertexCount;
+        uint32_t indexCount;
+    };
+
+    static constexpr uint32_t CACHE_VERSION = 2;  // 2 : géométrie passée par MeshOptimizer
+
+    static bool getSourceStamp(const std::string& sourcePath, uint64_t& outSize, int64_t& outTime);
+};
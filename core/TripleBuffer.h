@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class TripleBuffer
+ * @brief Échange sans verrou d'un état entre un producteur et un consommateur
+ *
+ * - Trois emplacements : écriture (producteur), lecture (consommateur), intermédiaire
+ * - publish() échange l'emplacement écrit avec l'intermédiaire et le marque "nouveau"
+ * - acquire() prend l'intermédiaire s'il est nouveau, sinon garde l'emplacement lu
+ * - Aucun côté n'attend l'autre : le consommateur lit toujours le dernier état
+ *   complet, des états intermédiaires peuvent être sautés
+ *
+ * Les emplacements sont réutilisés : le producteur réécrit tout l'état
+ * (les vecteurs gardent leur capacité, pas d'allocation en régime établi).
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    // ===== PRODUCTEUR =====
+
+    T& getWriteSlot() { return m_slots[m_write]; }
+
+    void publish() {
+        m_write = m_middle.exchange(m_write | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // ===== CONSOMMATEUR =====
+
+    bool hasFresh() const {
+        return (m_middle.load(std::memory_order_acquire) & FRESH_BIT) != 0;
+    }
+
+    /**
+     * @return true si un nouvel état a été pris
+     */
+    bool acquire() {
+        if (!hasFresh()) return false;
+        m_read = m_middle.exchange(m_read, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Emplacement lu : réservé au consommateur jusqu'au prochain acquire()
+     */
+    T& getReadSlot() { return m_slots[m_read]; }
+    const T& getReadSlot() const { return m_slots[m_read]; }
+
+private:
+    static constexpr uint32_t INDEX_MASK = 0x3u;
+    static constexpr uint32_t FRESH_BIT  = 0x4u;
+
+    T m_slots[3];
+    uint32_t m_write = 0;
+    uint32_t m_read  = 2;
+    std::atomic<uint32_t> m_middle{1};
+};
@@ -1,22 +1,38 @@
 #include "Window.h"
 #include <glm/glm.hpp>           // ADD THIS
 #include <glm/gtc/type_ptr.hpp>
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
 
+#ifdef MANCALA_HAS_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+static double steadySeconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
 Window::Window() : Window(Config{}) {}
 
-Window::Window(const Config& config) : m_window(nullptr) {
-    initGLFW(config);
-    loadGLAD();
-    setupCallbacks();
+Window::Window(const Config& config) : m_window(nullptr), m_headless(config.headless) {
+    if (m_headless) {
+        initHeadless(config);
+    } else {
+        initGLFW(config);
+        loadGLAD();
+        setupCallbacks();
+    }
 
     // Configuration OpenGL initiale
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
     
     // Anti-aliasing
-    if (config.msaaSamples > 0) {
+    if (config.msaaSamples > 0 && !m_headless) {
         glEnable(GL_MULTISAMPLE);
     }
 
@@ -25,13 +41,20 @@ Window::Window(const Config& config) : m_window(nullptr) {
     glCullFace(GL_BACK);
     glFrontFace(GL_CCW);
 
-    setVSync(config.vsync);
+    if (!m_headless) {
+        setVSync(config.vsync);
+    }
 
     std::cout << "[Window] OpenGL " << glGetString(GL_VERSION) << std::endl;
     std::cout << "[Window] Renderer: " << glGetString(GL_RENDERER) << std::endl;
 }
 
 Window::~Window() {
+    if (m_headless) {
+        destroyHeadless();
+        return;
+    }
+
     if (m_window) {
         glfwDestroyWindow(m_window);
     }
@@ -69,11 +92,142 @@ void Window::initGLFW(const Config& config) {
     glfwSetWindowUserPointer(m_window, this);
 }
 
+void Window::initHeadless(const Config& config) {
+#ifdef MANCALA_HAS_EGL
+    // Surfaceless Mesa platform first (no X/Wayland), then the default display
+    EGLDisplay display = EGL_NO_DISPLAY;
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (display == EGL_NO_DISPLAY) {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+        throw std::runtime_error("Failed to initialize EGL display");
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        eglTerminate(display);
+        throw std::runtime_error("EGL: desktop OpenGL API unavailable");
+    }
+
+    // Contexte sans config si possible (aucune surface n'est créée) ; sinon une
+    // config pbuffer : la plateforme surfaceless de Mesa n'expose que celles-là,
+    // EGL_SURFACE_TYPE vaut EGL_WINDOW_BIT par défaut
+    EGLConfig eglConfig = nullptr;
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+    const bool noConfigContext = extensions && std::strstr(extensions, "EGL_KHR_no_config_context");
+    if (noConfigContext) {
+        eglConfig = EGL_NO_CONFIG_KHR;
+    } else {
+        const EGLint configAttribs[] = {
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_NONE
+        };
+        EGLint numConfigs = 0;
+        if (!eglChooseConfig(display, configAttribs, &eglConfig, 1, &numConfigs) || numConfigs == 0) {
+            eglTerminate(display);
+            throw std::runtime_error("EGL: no OpenGL config");
+        }
+    }
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, config.openglMajor,
+        EGL_CONTEXT_MINOR_VERSION, config.openglMinor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, eglConfig, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT) {
+        eglTerminate(display);
+        throw std::runtime_error("EGL: failed to create OpenGL context");
+    }
+
+    // Pas de surface : tout le rendu passe par le FBO offscreen
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        eglDestroyContext(display, context);
+        eglTerminate(display);
+        throw std::runtime_error("EGL: surfaceless context not supported");
+    }
+
+    m_eglDisplay = display;
+    m_eglContext = context;
+
+    // Une exception sortant du constructeur n'appelle pas ~Window : libérer ici
+    try {
+        int version = gladLoadGL(reinterpret_cast<GLADloadfunc>(eglGetProcAddress));
+        if (version == 0) {
+            throw std::runtime_error("Failed to initialize GLAD");
+        }
+        m_glMajor = GLAD_VERSION_MAJOR(version);
+        m_glMinor = GLAD_VERSION_MINOR(version);
+
+        createOffscreenTarget(config.width, config.height);
+    } catch (...) {
+        destroyHeadless();
+        throw;
+    }
+    m_startTime = steadySeconds();
+#else
+    (void)config;
+    throw std::runtime_error("Headless mode requires a build with EGL support");
+#endif
+}
+
+void Window::destroyHeadless() {
+    // Objets GL : non nuls seulement si GLAD est chargé
+    if (m_fbo) glDeleteFramebuffers(1, &m_fbo);
+    if (m_colorRenderbuffer) glDeleteRenderbuffers(1, &m_colorRenderbuffer);
+    if (m_depthRenderbuffer) glDeleteRenderbuffers(1, &m_depthRenderbuffer);
+    m_fbo = m_colorRenderbuffer = m_depthRenderbuffer = 0;
+
+#ifdef MANCALA_HAS_EGL
+    if (m_eglDisplay) {
+        EGLDisplay display = static_cast<EGLDisplay>(m_eglDisplay);
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (m_eglContext) eglDestroyContext(display, static_cast<EGLContext>(m_eglContext));
+        eglTerminate(display);
+    }
+#endif
+    m_eglDisplay = nullptr;
+    m_eglContext = nullptr;
+}
+
+void Window::createOffscreenTarget(int width, int height) {
+    m_offscreenWidth = width;
+    m_offscreenHeight = height;
+
+    glGenRenderbuffers(1, &m_colorRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenRenderbuffers(1, &m_depthRenderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthRenderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    glGenFramebuffers(1, &m_fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorRenderbuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depthRenderbuffer);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        throw std::runtime_error("Offscreen framebuffer incomplete");
+    }
+
+    // Reste lié : le reste du code dessine comme dans le framebuffer par défaut
+    glViewport(0, 0, width, height);
+}
+
 void Window::loadGLAD() {
     int version = gladLoadGL(glfwGetProcAddress);
     if (version == 0) {
         throw std::runtime_error("Failed to initialize GLAD");
     }
+    m_glMajor = GLAD_VERSION_MAJOR(version);
+    m_glMinor = GLAD_VERSION_MINOR(version);
 }
 
 void Window::setupCallbacks() {
@@ -103,10 +257,14 @@ void Window::setupCallbacks() {
         auto* self = static_cast<Window*>(glfwGetWindowUserPointer(w));
         self->onKey(key, scancode, action, mods);
     });
+
+    // Window contents damaged (uncovered, restored...)
+    glfwSetWindowRefreshCallback(m_window, refreshCallbackStatic);
 }
 
 void Window::framebufferSizeCallbackStatic(GLFWwindow* window, int width, int height) {
     auto* win = static_cast<Window*>(glfwGetWindowUserPointer(window));
+    win->m_eventsPending = true;
     glViewport(0, 0, width, height);
     
     if (win->m_framebufferCallback) {
@@ -114,7 +272,13 @@ void Window::framebufferSizeCallbackStatic(GLFWwindow* window, int width, int he
     }
 }
 
+void Window::refreshCallbackStatic(GLFWwindow* window) {
+    auto* win = static_cast<Window*>(glfwGetWindowUserPointer(window));
+    win->m_eventsPending = true;
+}
+
 void Window::onMouseButton(int button, int action, int mods) {
+    m_eventsPending = true;
     if (button == GLFW_MOUSE_BUTTON_RIGHT) {
         m_rightMouseDown = (action == GLFW_PRESS);
         if (m_rightMouseDown) {
@@ -124,6 +288,7 @@ void Window::onMouseButton(int button, int action, int mods) {
 }
 
 void Window::onMouseMove(double x, double y) {
+    m_eventsPending = true;
     if (m_firstMouse) {
         m_lastMouseX = x;
         m_lastMouseY = y;
@@ -147,12 +312,14 @@ void Window::onMouseMove(double x, double y) {
 }
 
 void Window::onScroll(double dx, double dy) {
+    m_eventsPending = true;
     // Zoom in/out by changing distance
     m_distance -= static_cast<float>(dy) * 0.5f;
     m_distance = glm::clamp(m_distance, 2.0f, 20.0f);
 }
 
 void Window::onKey(int key, int scancode, int action, int mods) {
+    m_eventsPending = true;
     // ESC to close window
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
         glfwSetWindowShouldClose(m_window, GLFW_TRUE);
@@ -163,22 +330,58 @@ void Window::onKey(int key, int scancode, int action, int mods) {
 }
 
 bool Window::shouldClose() const {
+    if (m_headless) return m_closeRequested;
     return glfwWindowShouldClose(m_window);
 }
 
+void Window::requestClose() {
+    m_closeRequested = true;
+    if (m_window) {
+        glfwSetWindowShouldClose(m_window, GLFW_TRUE);
+    }
+}
+
 void Window::pollEvents() {
+    if (m_headless) return;
     glfwPollEvents();
 }
 
+void Window::waitEvents(double timeoutSeconds) {
+    if (m_headless) return;
+    glfwWaitEventsTimeout(timeoutSeconds);
+}
+
+bool Window::consumeEvents() {
+    bool pending = m_eventsPending;
+    m_eventsPending = false;
+    return pending;
+}
+
 void Window::swapBuffers() {
+    if (m_headless) {
+        // Pas de présentation : on attend le GPU pour mesurer la frame réelle
+        glFinish();
+        return;
+    }
     glfwSwapBuffers(m_window);
 }
 
+double Window::getTime() const {
+    if (m_headless) return steadySeconds() - m_startTime;
+    return glfwGetTime();
+}
+
 void Window::getFramebufferSize(int& width, int& height) const {
+    if (m_headless) {
+        width = m_offscreenWidth;
+        height = m_offscreenHeight;
+        return;
+    }
     glfwGetFramebufferSize(m_window, &width, &height);
 }
 
 void Window::setVSync(bool enabled) {
+    if (m_headless) return;
     glfwSwapInterval(enabled ? 1 : 0);
 }
 
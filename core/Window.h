@@ -14,6 +14,10 @@ public:
         int openglMinor = 3;
         int msaaSamples = 4;
         bool vsync = true;
+
+        // Offscreen rendering (EGL surfaceless + FBO), no GLFW window or X server.
+        // Requires a build with EGL (MANCALA_HAS_EGL).
+        bool headless = false;
     };
 
     Window();
@@ -24,13 +28,30 @@ public:
     Window& operator=(const Window&) = delete;
 
     bool shouldClose() const;
+    void requestClose();
     void pollEvents();
+    // Sleeps until an event arrives or the timeout expires (render-on-demand idle)
+    void waitEvents(double timeoutSeconds);
+    // True if input/window events (mouse, keys, resize, expose) arrived since the last call
+    bool consumeEvents();
     void swapBuffers();
+    double getTime() const;
     void getFramebufferSize(int& width, int& height) const;
     void setVSync(bool enabled);
     void setFramebufferSizeCallback(std::function<void(int, int)> callback);
 
     GLFWwindow* getGLFWWindow() const { return m_window; }
+    bool isHeadless() const { return m_headless; }
+
+    // Offscreen framebuffer (0 when rendering to the window)
+    GLuint getFramebuffer() const { return m_fbo; }
+
+    // OpenGL version actually provided by the driver (may exceed the requested one)
+    int getGLMajor() const { return m_glMajor; }
+    int getGLMinor() const { return m_glMinor; }
+    bool supportsGLVersion(int major, int minor) const {
+        return m_glMajor > major || (m_glMajor == major && m_glMinor >= minor);
+    }
 
     // Camera control getters
     float getYaw() const { return m_yaw; }
@@ -38,21 +59,30 @@ public:
     float getDistance() const { return m_distance; }
     
     // Keyboard state
-    bool isKeyPressed(int key) const { return glfwGetKey(m_window, key) == GLFW_PRESS; }
+    bool isKeyPressed(int key) const { return m_window && glfwGetKey(m_window, key) == GLFW_PRESS; }
 
 private:
     void initGLFW(const Config& config);
+    void initHeadless(const Config& config);
+    void createOffscreenTarget(int width, int height);
+    void destroyHeadless();
     void loadGLAD();
     void setupCallbacks();
 
     // Callback handlers
     static void framebufferSizeCallbackStatic(GLFWwindow* window, int width, int height);
+    static void refreshCallbackStatic(GLFWwindow* window);
     void onMouseButton(int button, int action, int mods);
     void onMouseMove(double x, double y);
     void onScroll(double dx, double dy);
     void onKey(int key, int scancode, int action, int mods);
 
     GLFWwindow* m_window;
+    bool m_headless = false;
+    bool m_closeRequested = false;
+    bool m_eventsPending = false;
+    int m_glMajor = 0;
+    int m_glMinor = 0;
     std::function<void(int, int)> m_framebufferCallback;
 
     // Mouse state
@@ -68,6 +98,16 @@ private:
     float m_pitch = -20.0f;    // Vertical rotation
     float m_distance = 8.0f;   // Distance from target
 
+    // Headless state (EGL handles kept opaque to avoid leaking EGL headers)
+    void* m_eglDisplay = nullptr;
+    void* m_eglContext = nullptr;
+    GLuint m_fbo = 0;
+    GLuint m_colorRenderbuffer = 0;
+    GLuint m_depthRenderbuffer = 0;
+    int m_offscreenWidth = 0;
+    int m_offscreenHeight = 0;
+    double m_startTime = 0.0;
+
     // Camera panning (optional)
     float m_panX = 0.0f;
     float m_panY = 0.0f;
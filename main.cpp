@@ -5,11 +5,19 @@
 #include "core/Window.h"
 #include "Rendering/Camera.h"
 #include "Rendering/shader.h"
+#include "Rendering/ShaderPermutations.h"
 #include "Scene/GameObject.h"
+#include "Scene/SceneBVH.h"
 #include "Game/MancalaGame.h"
+#include "Game/SimulationThread.h"
 #include "Interaction/ObjectPicker.h"
 #include "Rendering/RenderModeManager.h"
 #include "Rendering/TextureManager.h"
+#include "Rendering/IndirectRenderer.h"
+#include "Rendering/FrameProfiler.h"
+#include "Rendering/FrameCapture.h"
+#include "Rendering/LightClusterer.h"
+#include "Rendering/RedrawScheduler.h"
 #include "Game/ThemeManager.h"
 
 // ImGui
@@ -21,27 +29,48 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
 #include <vector>
 #include <string>
+#include <memory>
 #include <cmath>
+#include <cctype>
+#include <cstdlib>
+#include <algorithm>
+#include <unordered_map>
+#include <random>
+#include <chrono>
 
 // ===== CONFIGURATION =====
 constexpr int   WINDOW_WIDTH      = 1280;
 constexpr int   WINDOW_HEIGHT     = 720;
 constexpr float CAMERA_PAN_SPEED  = 0.05f;
+constexpr float WIREFRAME_LINE_WIDTH = 1.5f;   // SHADED_WIRE edges, in pixels
+constexpr int   DEFAULT_BENCHMARK_FRAMES = 600;
+constexpr int   BENCHMARK_WARMUP_FRAMES  = 10;
+constexpr int   DEFAULT_PICKING_BENCH_BOXES = 4096;
+constexpr int   PICKING_BENCH_RAYS          = 2000;
 
 // ===== GLOBAL STATE =====
 struct AppState {
     MancalaGame* game = nullptr;
 
+    // Game updates run on their own thread; rendering reads its latest snapshot
+    std::unique_ptr<SimulationThread> simulation;
+    std::vector<GameObject*> sceneObjects;   // into the current snapshot's copies
+    SceneBVH sceneBVH;                       // over sceneObjects, refit per snapshot (picking, ray queries)
+    int lightsThemeIndex = -1;               // theme the light colors were built for
+
     RenderModeManager& renderMode   = RenderModeManager::getInstance();
     ThemeManager&      themeManager = ThemeManager::getInstance();
     TextureManager&    textureMgr   = TextureManager::getInstance();
 
     glm::vec3 cameraTarget{0.0f, 0.0f, 0.0f};
 
-    // Hover state (optional)
-    GameObject* hoveredObject = nullptr;
+    // Hover state (pit index, -1 = none)
+    int hoveredPit = -1;
 
     // UI toggles
     bool showHelp  = true;
@@ -50,78 +79,149 @@ struct AppState {
     // Lighting toggle
     bool lightsEnabled = true;
 
+    // Small per-pit / board-rim accent lights (clustered, no count limit)
+    bool accentLights = false;
+
+    // GL 4.3 multi-draw indirect path (nullptr = GL 3.3 fallback)
+    std::unique_ptr<IndirectRenderer> indirect;
+    bool useIndirect = false;
+
+    // View-frustum culling
+    bool frustumCulling = true;
+    size_t totalObjects  = 0;   // frustum-tested (isVisible) objects
+    size_t culledObjects = 0;   // rejected by the frustum only
+
+    // Distance-based LOD + triangles submitted this frame (all passes)
+    bool lodEnabled = true;
+    size_t trianglesSubmitted  = 0;
+    size_t trianglesFullDetail = 0;   // same objects at LOD 0, for comparison
+    size_t vertexBytesSubmitted = 0;  // vertex buffer bytes referenced by this frame's draws
+
+    // CPU/GPU phase profiler shown in the Stats window
+    std::unique_ptr<FrameProfiler> profiler;
+
+    // Asynchronous screenshot / image sequence capture (PBO ring)
+    std::unique_ptr<FrameCapture> capture;
+
     // timing
     float deltaTime  = 0.0f;
     float lastFrame  = 0.0f;
 
-    // simple lights
-    struct Light {
-        glm::vec3 position;
-        glm::vec3 color;
-        float intensity;
-    };
+    // point lights, assigned to view-space clusters when they or the camera change
+    using Light = LightClusterer::PointLight;
     std::vector<Light> lights;
+    std::unique_ptr<LightClusterer> lightClusterer;
+    bool lightsChanged = true;                   // set by setupLights
+    unsigned int clusterCameraVersion = 0;       // Camera::getMatrixVersion of the last assignment
+
+    // Render on demand (--on-demand, P): dirty flags from every subsystem
+    RedrawScheduler redraw;
+};
+
+// Shader variants used by the current frame (see ShaderPermutations)
+struct FrameShaders {
+    Shader* untextured = nullptr;
+    Shader* textured   = nullptr;   // nullptr when the render mode ignores textures
 };
 
 // ===== Forward decl =====
+static void runInteractive(Window& window, Camera& camera, ShaderPermutations& shaders,
+                           ShaderPermutations* indirectShaders, AppState& state);
+static void runBenchmark(Window& window, Camera& camera, ShaderPermutations& shaders,
+                         ShaderPermutations* indirectShaders, AppState& state, int frames);
+static void runPickingBenchmark(int boxCount);
+static void updateOrbitCamera(Camera& camera, const glm::vec3& target, float yaw, float pitch, float distance);
+static void renderFrame(Camera& camera, ShaderPermutations& shaders, ShaderPermutations* indirectShaders,
+                        AppState& state, int fbWidth, int fbHeight);
 static void setupLights(AppState& state);
 static void processInput(Window& window, AppState& state);
 static void handleMousePicking(Window& window, Camera& camera, AppState& state);
-static void renderScene(Shader& shader, const std::vector<GameObject*>& objects, AppState& state);
-static void applyThemeToGame(AppState& state);
+static void applyFrameUniforms(Shader& shader, const Camera& camera, AppState& state,
+                               int fbWidth, int fbHeight);
+static void drawObjects(const FrameShaders& programs, const std::vector<GameObject*>& objects, AppState& state);
+static void selectLODs(const std::vector<GameObject*>& objects, const Camera& camera, AppState& state, int fbHeight);
+static std::vector<GameObject*> cullObjects(const std::vector<GameObject*>& objects, const Camera& camera, AppState& state);
+static void renderScene(const FrameShaders& programs, const std::vector<GameObject*>& objects, AppState& state);
+static bool isLightingActive(const AppState& state);
+static bool isTextured(const GameObject* obj, const AppState& state);
+static bool acquireSnapshot(AppState& state);
 static void drawImGuiHUD(AppState& state);
 
-// Re-apply theme to existing objects (board + pits + seeds)
-static void applyThemeToGame(AppState& state) {
-    auto objects = state.game->getAllObjects();
-    int seedIdx = 0;
-
-    // Board
-    if (!objects.empty() && objects[0]) {
-        state.themeManager.applyThemeToBoard(objects[0]);
-    }
-
-    // Pits + Seeds
-    const auto& pits = state.game->getPits();
-
-    for (const auto& pit : pits) {
-        if (pit.pitObject) {
-            state.themeManager.applyThemeToPit(pit.pitObject, pit.index);
+// ===== MAIN =====
+int main(int argc, char** argv) {
+    try {
+        // Command line: --headless (offscreen EGL), --benchmark [frames], --accent-lights,
+        //               --inverse-normals (legacy per-vertex normal matrix), --no-indirect, --no-lod,
+        //               --packed-vertices (16-byte vertex format), --on-demand (redraw only on change),
+        //               --bench-picking [boxes] (ray/box kernels, CPU only)
+        bool headless = false;
+        bool accentLights = false;
+        bool inverseNormals = false;
+        bool allowIndirect = true;
+        bool lodEnabled = true;
+        bool packedVertices = false;
+        bool onDemand = false;
+        int benchmarkFrames = 0;
+        int pickingBenchBoxes = 0;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--headless") {
+                headless = true;
+            } else if (arg == "--accent-lights") {
+                accentLights = true;
+            } else if (arg == "--inverse-normals") {
+                inverseNormals = true;
+            } else if (arg == "--no-indirect") {
+                allowIndirect = false;
+            } else if (arg == "--no-lod") {
+                lodEnabled = false;
+            } else if (arg == "--packed-vertices") {
+                packedVertices = true;
+            } else if (arg == "--on-demand") {
+                onDemand = true;
+            } else if (arg == "--bench-picking") {
+                pickingBenchBoxes = DEFAULT_PICKING_BENCH_BOXES;
+                if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                    pickingBenchBoxes = std::max(1, std::atoi(argv[++i]));
+                }
+            } else if (arg == "--benchmark") {
+                benchmarkFrames = DEFAULT_BENCHMARK_FRAMES;
+                if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                    benchmarkFrames = std::max(1, std::atoi(argv[++i]));
+                }
+            }
+        }
+        // No window or GL context needed
+        if (pickingBenchBoxes > 0) {
+            runPickingBenchmark(pickingBenchBoxes);
+            return 0;
         }
-    }
 
-    for (const auto& pit : pits) {
-        for (auto* seed : pit.seeds) {
-            if (seed) state.themeManager.applyThemeToSeed(seed, seedIdx++);
+        // Offscreen only makes sense for scripted runs
+        if (headless && benchmarkFrames == 0) {
+            benchmarkFrames = DEFAULT_BENCHMARK_FRAMES;
         }
-    }
-}
 
-// ===== MAIN =====
-int main() {
-    try {
         // Create window
         Window::Config config;
         config.width       = WINDOW_WIDTH;
         config.height      = WINDOW_HEIGHT;
         config.title       = "Mancala 3D - Interactive Game";
         config.msaaSamples = 4;
-        config.vsync       = true;
+        config.vsync       = (benchmarkFrames == 0);
+        config.headless    = headless;
 
         Window window(config);
 
-        // Keep viewport correct if resized
-        window.setFramebufferSizeCallback([&](int w, int h) {
-            glViewport(0, 0, w, h);
-        });
-
         // ===== ImGui init =====
-        IMGUI_CHECKVERSION();
-        ImGui::CreateContext();
-        ImGui::StyleColorsDark();
+        if (!window.isHeadless()) {
+            IMGUI_CHECKVERSION();
+            ImGui::CreateContext();
+            ImGui::StyleColorsDark();
 
-        ImGui_ImplGlfw_InitForOpenGL(window.getGLFWWindow(), true);
-        ImGui_ImplOpenGL3_Init("#version 330");
+            ImGui_ImplGlfw_InitForOpenGL(window.getGLFWWindow(), true);
+            ImGui_ImplOpenGL3_Init("#version 330");
+        }
 
         // Setup camera
         int fbW, fbH;
@@ -136,105 +236,215 @@ int main() {
             100.0f
         );
 
-        // Load shader
-        Shader shader("Shaders/phong.vs", "Shaders/phong.fs");
+        // Keep viewport and projection correct if resized (minimized: 0 height, keep the old aspect)
+        window.setFramebufferSizeCallback([&](int w, int h) {
+            glViewport(0, 0, w, h);
+            if (h > 0) camera.setAspect(static_cast<float>(w) / static_cast<float>(h));
+        });
+
+        // Load shaders: one program per feature combination (ShaderPermutations), all
+        // submitted together so the driver can compile them in parallel; linked
+        // binaries are cached in shadercache/
+        // (the MDI shaders read their normal matrix from the draw data: the
+        // --inverse-normals reference only exists on the per-object path)
+        const bool indirectSupported = allowIndirect && !inverseNormals &&
+            IndirectRenderer::isSupported(window.getGLMajor(), window.getGLMinor());
+
+        // A/B reference: same shader with transpose(inverse(model)) evaluated per vertex
+        Shader::ProgramSource sceneSource =
+            Shader::loadSources("Shaders/phong.vs", "Shaders/phong.fs", "Shaders/wireframe.gs");
+        if (inverseNormals) {
+            sceneSource.vertex = ShaderPermutations::injectDefines(sceneSource.vertex, "#define USE_INVERSE_NORMALS\n");
+            sceneSource.label += " (inverse normals)";
+            GameObject::setInverseNormalReference(true);
+            std::cout << "[Render] Using per-vertex inverse normal matrix (reference, per-object draws)\n";
+        }
+        ShaderPermutations sceneShaders(std::move(sceneSource));
+
+        std::unique_ptr<ShaderPermutations> indirectShaders;
+        if (indirectSupported) {
+            Shader::ProgramSource indirectSource =
+                Shader::loadSources("Shaders/phong_mdi.vs", "Shaders/phong_mdi.fs", "Shaders/wireframe.gs");
+            indirectSource.geometry = ShaderPermutations::injectDefines(indirectSource.geometry, "#define WITH_DRAW_ID\n");
+            indirectShaders = std::make_unique<ShaderPermutations>(std::move(indirectSource));
+        }
+        ShaderPermutations::precompile({ &sceneShaders, indirectShaders.get() });
 
         // Init app state
         AppState state;
+
+        // Optional single-call submission path (GL 4.3+)
+        if (indirectSupported) {
+            state.indirect = std::make_unique<IndirectRenderer>();
+            state.useIndirect = true;
+            std::cout << "[Render] Multi-draw indirect path enabled\n";
+        } else {
+            std::cout << "[Render] GL 4.3 unavailable, using per-object draws\n";
+        }
+        if (packedVertices) {
+            Mesh::setDefaultVertexFormat(VertexFormat::PACKED);
+            std::cout << "[Render] Packed vertex format (" << sizeof(PackedVertex) << " bytes/vertex)\n";
+        }
         state.game = new MancalaGame();
         state.game->initialize();
-        setupLights(state);
+        state.accentLights = accentLights;
+        state.lodEnabled = lodEnabled;
+        state.redraw.setOnDemand(onDemand && benchmarkFrames == 0);
+        state.lightClusterer = std::make_unique<LightClusterer>();
+        state.profiler = std::make_unique<FrameProfiler>();
+        state.capture  = std::make_unique<FrameCapture>();
+
+        // Apply initial theme once; other themes' textures decode in the background
+        // (every theme's texture handle exists before the simulation thread can switch)
+        state.game->applyTheme();
+        state.themeManager.preloadTextures();
+
+        // From here on the game is only touched through the simulation (commands)
+        state.simulation = std::make_unique<SimulationThread>(*state.game);
+        acquireSnapshot(state);
+
+        if (benchmarkFrames > 0) {
+            // Stepped on this thread: same simulated frames on every run
+            runBenchmark(window, camera, sceneShaders, indirectShaders.get(), state, benchmarkFrames);
+        } else {
+            // Wakes the render loop when it sleeps in render-on-demand mode
+            state.simulation->setPublishCallback([] { glfwPostEmptyEvent(); });
+            state.simulation->start();
+            runInteractive(window, camera, sceneShaders, indirectShaders.get(), state);
+        }
+        state.simulation->stop();
 
-        // Apply initial theme once
-        applyThemeToGame(state);
-
-        // Print controls (console)
-        std::cout << "\n=============== MANCALA 3D ===============\n";
-        std::cout << "=== CAMERA CONTROLS ===\n";
-        std::cout << "  Right Mouse + Drag : Orbit camera\n";
-        std::cout << "  Mouse Wheel        : Zoom in/out\n";
-        std::cout << "  W/A/S/D/Q/E       : Pan camera\n\n";
-        std::cout << "=== GAME CONTROLS ===\n";
-        std::cout << "  Left Click         : Select pit & play\n";
-        std::cout << "  R                  : Reset game\n\n";
-        std::cout << "=== DISPLAY CONTROLS ===\n";
-        std::cout << "  M                  : Cycle render mode\n";
-        std::cout << "  T                  : Change theme\n";
-        std::cout << "  L                  : Toggle lighting\n";
-        std::cout << "  H                  : Toggle help\n";
-        std::cout << "  F                  : Toggle stats\n";
-        std::cout << "  ESC                : Exit\n";
-        std::cout << "=========================================\n\n";
-
-        // Main loop
-        while (!window.shouldClose()) {
-            // delta time
-            float currentFrame = static_cast<float>(glfwGetTime());
-            state.deltaTime = currentFrame - state.lastFrame;
-            state.lastFrame = currentFrame;
+        // ===== ImGui shutdown =====
+        if (!window.isHeadless()) {
+            ImGui_ImplOpenGL3_Shutdown();
+            ImGui_ImplGlfw_Shutdown();
+            ImGui::DestroyContext();
+        }
 
+        // cleanup
+        state.simulation.reset();
+        state.sceneObjects.clear();
+        state.indirect.reset();
+        state.profiler.reset();
+        state.capture.reset();   // flushes pending frames to disk
+        state.lightClusterer.reset();
+        delete state.game;
+        state.textureMgr.cleanup();
+
+        return 0;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << "\n";
+        return -1;
+    }
+}
+
+static void runInteractive(Window& window, Camera& camera, ShaderPermutations& shaders,
+                           ShaderPermutations* indirectShaders, AppState& state) {
+    // Print controls (console)
+    std::cout << "\n=============== MANCALA 3D ===============\n";
+    std::cout << "=== CAMERA CONTROLS ===\n";
+    std::cout << "  Right Mouse + Drag : Orbit camera\n";
+    std::cout << "  Mouse Wheel        : Zoom in/out\n";
+    std::cout << "  W/A/S/D/Q/E       : Pan camera\n\n";
+    std::cout << "=== GAME CONTROLS ===\n";
+    std::cout << "  Left Click         : Select pit & play\n";
+    std::cout << "  R                  : Reset game\n\n";
+    std::cout << "=== DISPLAY CONTROLS ===\n";
+    std::cout << "  M                  : Cycle render mode\n";
+    std::cout << "  T                  : Change theme\n";
+    std::cout << "  L                  : Toggle lighting\n";
+    std::cout << "  K                  : Toggle accent lights\n";
+    std::cout << "  I                  : Toggle multi-draw indirect\n";
+    std::cout << "  C                  : Toggle frustum culling\n";
+    std::cout << "  O                  : Toggle mesh LOD\n";
+    std::cout << "  P                  : Toggle render on demand\n";
+    std::cout << "  H                  : Toggle help\n";
+    std::cout << "  F                  : Toggle stats\n";
+    std::cout << "  F12                : Screenshot\n";
+    std::cout << "  F11                : Start/stop image sequence\n";
+    std::cout << "  ESC                : Exit\n";
+    std::cout << "=========================================\n\n";
+
+    // Main loop
+    while (!window.shouldClose()) {
+        FrameProfiler& profiler = *state.profiler;
+        RedrawScheduler& redraw = state.redraw;
+
+        // Sources that change the picture without any input event
+        if (state.simulation->getSnapshot().animating) redraw.invalidate(RedrawScheduler::ANIMATION);
+        if (state.textureMgr.getPendingCount() > 0) redraw.invalidate(RedrawScheduler::RESOURCES);
+        if (state.capture->isRecording() || state.capture->hasPendingReadbacks()) {
+            redraw.invalidate(RedrawScheduler::CAPTURE);
+        }
+
+        // Render on demand: sleep in the event queue while nothing is dirty
+        if (redraw.hasPendingWork()) {
             window.pollEvents();
+        } else {
+            window.waitEvents(RedrawScheduler::IDLE_TIMEOUT);
+        }
+        if (window.consumeEvents()) redraw.invalidate(RedrawScheduler::INPUT);
+        if (state.simulation->hasNewSnapshot()) redraw.invalidate(RedrawScheduler::GAME);
+
+        if (!redraw.beginFrame()) {
+            // Nothing changed: no update, draw or swap (idle time is not a frame)
+            state.lastFrame = static_cast<float>(window.getTime());
+            profiler.skipFrame();
+            continue;
+        }
+
+        profiler.beginFrame();
+
+        // delta time
+        float currentFrame = static_cast<float>(window.getTime());
+        state.deltaTime = currentFrame - state.lastFrame;
+        state.lastFrame = currentFrame;
+
+        {
+            FrameProfiler::Scope phase(profiler, FrameProfiler::Phase::INPUT);
 
             // Input
             processInput(window, state);
 
             // Update camera from Window orbit controls
-            float yaw      = window.getYaw();
-            float pitch    = window.getPitch();
-            float distance = window.getDistance();
-
-            glm::vec3 direction;
-            direction.x = std::cos(glm::radians(yaw)) * std::cos(glm::radians(pitch));
-            direction.y = std::sin(glm::radians(pitch));
-            direction.z = std::sin(glm::radians(yaw)) * std::cos(glm::radians(pitch));
-
-            glm::vec3 cameraPos = state.cameraTarget - glm::normalize(direction) * distance;
-            camera.setPosition(cameraPos);
-            camera.lookAt(state.cameraTarget);
-
-            // Update game animation
-            if (state.game->isAnimating()) {
-                state.game->updateAnimation(state.deltaTime);
-            }
-
-            // Mouse picking & click-to-play (respects ImGui capture)
-            handleMousePicking(window, camera, state);
+            glm::vec3 previousPosition = camera.getPosition();
+            updateOrbitCamera(camera, state.cameraTarget,
+                              window.getYaw(), window.getPitch(), window.getDistance());
+            if (camera.getPosition() != previousPosition) redraw.invalidate(RedrawScheduler::CAMERA);
+        }
 
-            // Render 3D
-            glClearColor(0.10f, 0.10f, 0.15f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        // Latest game state from the simulation thread (animation runs there)
+        {
+            FrameProfiler::Scope phase(profiler, FrameProfiler::Phase::ANIMATION);
+            acquireSnapshot(state);
+        }
 
-            shader.use();
+        // Mouse picking & click-to-play (respects ImGui capture)
+        {
+            FrameProfiler::Scope phase(profiler, FrameProfiler::Phase::PICKING);
+            handleMousePicking(window, camera, state);
+        }
 
-            // matrices
-            shader.setMat4("view", camera.getViewMatrix());
-            shader.setMat4("projection", camera.getProjectionMatrix());
-            shader.setVec3("viewPos", camera.getPosition());
+        // Render 3D
+        {
+            FrameProfiler::Scope phase(profiler, FrameProfiler::Phase::SCENE);
 
-            // textures usage depends on render mode
-            shader.setBool("useTextures", state.renderMode.shouldUseTextures());
+            // Decoded textures reach the GPU a few MB per frame
+            state.textureMgr.processUploads();
 
-            // lighting toggle
-            // IMPORTANT: your phong.fs must have:
-            //   uniform bool lightingEnabled;
-            shader.setBool("lightingEnabled", state.lightsEnabled);
+            int fbW, fbH;
+            window.getFramebufferSize(fbW, fbH);
+            renderFrame(camera, shaders, indirectShaders, state, fbW, fbH);
 
-            if (state.lightsEnabled) {
-                shader.setInt("numLights", static_cast<int>(state.lights.size()));
-                for (size_t i = 0; i < state.lights.size(); ++i) {
-                    std::string base = "lights[" + std::to_string(i) + "]";
-                    shader.setVec3(base + ".position", state.lights[i].position);
-                    shader.setVec3(base + ".color", state.lights[i].color);
-                    shader.setFloat(base + ".intensity", state.lights[i].intensity);
-                }
-            } else {
-                shader.setInt("numLights", 0);
-            }
+            // Scene only (no HUD); readback completes asynchronously a few frames later
+            state.capture->captureFrame(fbW, fbH);
+        }
 
-            // draw objects
-            renderScene(shader, state.game->getAllObjects(), state);
+        // ===== ImGui frame =====
+        {
+            FrameProfiler::Scope phase(profiler, FrameProfiler::Phase::IMGUI);
 
-            // ===== ImGui frame =====
             ImGui_ImplOpenGL3_NewFrame();
             ImGui_ImplGlfw_NewFrame();
             ImGui::NewFrame();
@@ -249,31 +459,270 @@ int main() {
             ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
             glEnable(GL_DEPTH_TEST);
             glEnable(GL_CULL_FACE);
+        }
 
+        {
+            FrameProfiler::Scope phase(profiler, FrameProfiler::Phase::SWAP);
             window.swapBuffers();
         }
 
-        // ===== ImGui shutdown =====
-        ImGui_ImplOpenGL3_Shutdown();
-        ImGui_ImplGlfw_Shutdown();
-        ImGui::DestroyContext();
+        profiler.endFrame();
+    }
+}
 
-        // cleanup
-        delete state.game;
-        state.textureMgr.cleanup();
+static void runBenchmark(Window& window, Camera& camera, ShaderPermutations& shaders,
+                         ShaderPermutations* indirectShaders, AppState& state, int frames) {
+    int width, height;
+    window.getFramebufferSize(width, height);
 
-        return 0;
+    std::cout << "[Benchmark] " << frames << " frames at " << width << "x" << height
+              << (window.isHeadless() ? " (headless)" : "")
+              << " on " << glGetString(GL_RENDERER) << "\n";
+
+    // Scripted scene: deterministic per frame index, independent of wall-clock time
+    const float dt = 1.0f / 60.0f;
+    std::vector<float> frameTimes;
+    frameTimes.reserve(frames);
+    double trianglesTotal = 0.0, trianglesFullTotal = 0.0, vertexBytesTotal = 0.0;
+
+    FrameProfiler& profiler = *state.profiler;
+
+    for (int frame = 0; frame < BENCHMARK_WARMUP_FRAMES + frames && !window.shouldClose(); ++frame) {
+        double start = window.getTime();
+        profiler.beginFrame();
+
+        window.pollEvents();
+
+        // Orbit + slow zoom so culling and distance-dependent work vary
+        float t = static_cast<float>(frame);
+        updateOrbitCamera(camera, state.cameraTarget,
+                          -90.0f + t * 0.6f,
+                          -25.0f + 10.0f * std::sin(t * 0.01f),
+                          8.0f + 4.0f * std::sin(t * 0.005f));
+
+        {
+            FrameProfiler::Scope phase(profiler, FrameProfiler::Phase::ANIMATION);
+
+            // Play the first legal move every half second of simulated time
+            const RenderSnapshot& snapshot = state.simulation->getSnapshot();
+            if (frame % 30 == 0 && !snapshot.animating) {
+                if (snapshot.isGameOver()) {
+                    state.simulation->submit({ SimulationThread::CommandType::RESET });
+                } else {
+                    for (int pit = 0; pit < static_cast<int>(snapshot.pits.size()); ++pit) {
+                        if (snapshot.pits[pit].validMove) {
+                            state.simulation->submit({ SimulationThread::CommandType::PLAY_MOVE, pit });
+                            break;
+                        }
+                    }
+                }
+            }
+            state.simulation->step(dt);
+            acquireSnapshot(state);
+        }
+
+        {
+            FrameProfiler::Scope phase(profiler, FrameProfiler::Phase::SCENE);
+            state.textureMgr.processUploads();
+            renderFrame(camera, shaders, indirectShaders, state, width, height);
+        }
+
+        {
+            FrameProfiler::Scope phase(profiler, FrameProfiler::Phase::SWAP);
+            window.swapBuffers();
+        }
+
+        profiler.endFrame();
+
+        if (frame >= BENCHMARK_WARMUP_FRAMES) {
+            trianglesTotal     += static_cast<double>(state.trianglesSubmitted);
+            trianglesFullTotal += static_cast<double>(state.trianglesFullDetail);
+            vertexBytesTotal   += static_cast<double>(state.vertexBytesSubmitted);
+            frameTimes.push_back(static_cast<float>((window.getTime() - start) * 1000.0));
+        }
     }
-    catch (const std::exception& e) {
-        std::cerr << "ERROR: " << e.what() << "\n";
-        return -1;
+
+    FrameProfiler::Stats stats = FrameProfiler::summarize(frameTimes);
+    std::cout << "[Benchmark] frame ms: avg " << stats.avg
+              << " | p95 " << stats.p95
+              << " | p99 " << stats.p99
+              << " | max " << stats.max
+              << " | fps " << (stats.avg > 0.0f ? 1000.0f / stats.avg : 0.0f) << "\n";
+
+    const FrameProfiler::Phase phases[] = {
+        FrameProfiler::Phase::ANIMATION, FrameProfiler::Phase::SCENE, FrameProfiler::Phase::SWAP
+    };
+    for (auto phase : phases) {
+        FrameProfiler::Stats cpu = profiler.getCpuStats(phase);
+        FrameProfiler::Stats gpu = profiler.getGpuStats(phase);
+        std::cout << "[Benchmark]   " << FrameProfiler::getPhaseName(phase)
+                  << ": cpu avg " << cpu.avg << " p99 " << cpu.p99
+                  << " | gpu avg " << gpu.avg << " p99 " << gpu.p99
+                  << " (last " << FrameProfiler::HISTORY_SIZE << " frames)\n";
+    }
+    std::cout << "[Benchmark] culled " << state.culledObjects << " / " << state.totalObjects
+              << " objects on last frame, submit: "
+              << ((state.useIndirect && state.indirect) ? "MDI" : "per-object") << "\n";
+    if (!frameTimes.empty()) {
+        std::cout << "[Benchmark] triangles/frame: " << static_cast<size_t>(trianglesTotal / frameTimes.size())
+                  << " (LOD 0 would be " << static_cast<size_t>(trianglesFullTotal / frameTimes.size())
+                  << ")" << (state.lodEnabled ? "" : " LOD off") << "\n";
+        std::cout << "[Benchmark] vertex data/frame: " << vertexBytesTotal / frameTimes.size() / 1024.0
+                  << " KB ("
+                  << (Mesh::getDefaultVertexFormat() == VertexFormat::PACKED ? "packed" : "float") << ")\n";
     }
 }
 
+// Ray vs. AABB microbenchmark: one box per call (ObjectPicker::rayAABBIntersection),
+// SoA scalar and SoA SIMD (AABBPacket) over the same random boxes and rays
+static void runPickingBenchmark(int boxCount) {
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> halfSize(0.05f, 0.5f);
+
+    std::vector<glm::vec3> mins(boxCount), maxs(boxCount);
+    AABBPacket packet;
+    packet.resize(boxCount);
+    for (int i = 0; i < boxCount; ++i) {
+        glm::vec3 center(coordinate(rng), coordinate(rng) * 0.2f, coordinate(rng));
+        glm::vec3 extent(halfSize(rng), halfSize(rng), halfSize(rng));
+        mins[i] = center - extent;
+        maxs[i] = center + extent;
+        packet.set(i, mins[i], maxs[i]);
+    }
+
+    // Rays from a sphere around the scene towards random points inside it
+    std::vector<ObjectPicker::Ray> rays(PICKING_BENCH_RAYS);
+    for (auto& ray : rays) {
+        glm::vec3 from(coordinate(rng), coordinate(rng), coordinate(rng));
+        ray.origin = glm::normalize(from) * 25.0f;
+        glm::vec3 to(coordinate(rng), coordinate(rng) * 0.2f, coordinate(rng));
+        ray.direction = glm::normalize(to - ray.origin);
+    }
+
+    std::vector<float> distances(boxCount);
+    volatile float sink = 0.0f;
+    auto measure = [&](auto&& kernel) {
+        // Warm-up pass (caches, branch predictors), also used to count hits
+        size_t hits = 0;
+        for (const auto& ray : rays) {
+            kernel(ray, distances.data());
+            for (float d : distances) hits += (d < FLT_MAX) ? 1 : 0;
+        }
+
+        // Timed pass: kernel only; one read per ray keeps the results live
+        float checksum = 0.0f;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rays.size(); ++r) {
+            kernel(rays[r], distances.data());
+            checksum += distances[r % boxCount];
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        sink = checksum;
+        return std::make_pair(ns / (static_cast<double>(rays.size()) * boxCount), hits);
+    };
+
+    auto perBox = measure([&](const ObjectPicker::Ray& ray, float* out) {
+        for (int i = 0; i < boxCount; ++i) {
+            float d;
+            out[i] = ObjectPicker::rayAABBIntersection(ray, mins[i], maxs[i], d) ? d : FLT_MAX;
+        }
+    });
+    auto scalar = measure([&](const ObjectPicker::Ray& ray, float* out) {
+        packet.intersectScalar(ray.origin, 1.0f / ray.direction, 0, boxCount, FLT_MAX, out);
+    });
+    auto simd = measure([&](const ObjectPicker::Ray& ray, float* out) {
+        packet.intersect(ray.origin, 1.0f / ray.direction, 0, boxCount, FLT_MAX, out);
+    });
+
+    // Same math in both SoA kernels: results must agree
+    size_t mismatches = 0;
+    std::vector<float> reference(boxCount);
+    for (const auto& ray : rays) {
+        glm::vec3 invDirection = 1.0f / ray.direction;
+        packet.intersectScalar(ray.origin, invDirection, 0, boxCount, FLT_MAX, reference.data());
+        packet.intersect(ray.origin, invDirection, 0, boxCount, FLT_MAX, distances.data());
+        for (int i = 0; i < boxCount; ++i) {
+            if ((reference[i] < FLT_MAX) != (distances[i] < FLT_MAX) ||
+                std::abs(reference[i] - distances[i]) > 1e-4f * std::max(1.0f, reference[i])) {
+                ++mismatches;
+            }
+        }
+    }
+
+    std::cout << "[Benchmark] picking: " << boxCount << " boxes x " << rays.size() << " rays, kernel "
+              << AABBPacket::getKernelName() << "\n";
+    std::cout << "[Benchmark]   per-box (rayAABBIntersection): " << perBox.first << " ns/box\n";
+    std::cout << "[Benchmark]   SoA scalar: " << scalar.first << " ns/box\n";
+    std::cout << "[Benchmark]   SoA SIMD:   " << simd.first << " ns/box (x"
+              << (simd.first > 0.0 ? scalar.first / simd.first : 0.0) << " vs scalar, x"
+              << (simd.first > 0.0 ? perBox.first / simd.first : 0.0) << " vs per-box)\n";
+    std::cout << "[Benchmark]   hits/ray: " << static_cast<double>(simd.second) / rays.size()
+              << " (per-box " << static_cast<double>(perBox.second) / rays.size() << ")"
+              << ", SIMD/scalar mismatches: " << mismatches << "\n";
+}
+
 // ===== IMPLEMENTATION =====
 
+static void updateOrbitCamera(Camera& camera, const glm::vec3& target, float yaw, float pitch, float distance) {
+    glm::vec3 direction;
+    direction.x = std::cos(glm::radians(yaw)) * std::cos(glm::radians(pitch));
+    direction.y = std::sin(glm::radians(pitch));
+    direction.z = std::sin(glm::radians(yaw)) * std::cos(glm::radians(pitch));
+
+    glm::vec3 cameraPos = target - glm::normalize(direction) * distance;
+    camera.setPosition(cameraPos);
+    camera.lookAt(target);
+}
+
+static void renderFrame(Camera& camera, ShaderPermutations& shaders, ShaderPermutations* indirectShaders,
+                        AppState& state, int fbWidth, int fbHeight) {
+    glClearColor(0.10f, 0.10f, 0.15f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    ShaderPermutations& permutations =
+        (state.useIndirect && state.indirect && indirectShaders) ? *indirectShaders : shaders;
+
+    // Lighting is per frame; texturing depends on the render mode and on each object
+    const bool lighting = isLightingActive(state);
+    uint32_t features = lighting ? ShaderPermutations::LIGHTING : 0u;
+    if (state.renderMode.shouldDrawWireframeOverlay()) {
+        features |= ShaderPermutations::WIREFRAME;
+    }
+
+    FrameShaders programs;
+    programs.untextured = &permutations.get(features);
+    if (state.renderMode.shouldUseTextures()) {
+        programs.textured = &permutations.get(features | ShaderPermutations::TEXTURED);
+    }
+
+    // Cluster assignment depends only on the lights and the camera matrices: a still
+    // camera over an unchanged light set reuses last frame's buffers
+    const unsigned int cameraVersion = camera.getMatrixVersion();
+    if (lighting && (state.lightsChanged || cameraVersion != state.clusterCameraVersion)) {
+        state.lightClusterer->update(state.lights, camera.getViewMatrix(), camera.getFov(),
+                                     camera.getAspect(), camera.getNear(), camera.getFar());
+        state.clusterCameraVersion = cameraVersion;
+        state.lightsChanged = false;
+    }
+    applyFrameUniforms(*programs.untextured, camera, state, fbWidth, fbHeight);
+    if (programs.textured) {
+        applyFrameUniforms(*programs.textured, camera, state, fbWidth, fbHeight);
+    }
+
+    // draw objects
+    std::vector<GameObject*> visible = cullObjects(state.sceneObjects, camera, state);
+    selectLODs(visible, camera, state, fbHeight);
+
+    state.trianglesSubmitted   = 0;
+    state.trianglesFullDetail  = 0;
+    state.vertexBytesSubmitted = 0;
+    renderScene(programs, visible, state);
+}
+
 static void setupLights(AppState& state) {
     state.lights.clear();
+    state.lightsChanged = true;
 
     AppState::Light mainLight;
     mainLight.position  = glm::vec3(5.0f, 8.0f, 5.0f);
@@ -292,10 +741,50 @@ static void setupLights(AppState& state) {
     backLight.color     = glm::vec3(0.8f, 0.8f, 1.0f);
     backLight.intensity = 0.3f;
     state.lights.push_back(backLight);
+
+    const RenderSnapshot& snapshot = state.simulation->getSnapshot();
+    state.lightsThemeIndex = snapshot.themeIndex;
+    if (!state.accentLights) return;
+
+    // Accent lights: one small light above every pit/store plus a ring along the board rim.
+    // Short radii keep each one in a handful of clusters.
+    const auto& colors = state.themeManager.getTheme(snapshot.themeIndex).lightColors;
+    auto accentColor = [&](size_t i) {
+        return colors.empty() ? glm::vec3(1.0f) : colors[i % colors.size()];
+    };
+
+    size_t accentIndex = 0;
+    for (const auto& pit : snapshot.pits) {
+        AppState::Light accent;
+        accent.position  = pit.basePosition + glm::vec3(0.0f, 0.6f, 0.0f);
+        accent.color     = accentColor(accentIndex++);
+        accent.intensity = 0.6f;
+        accent.radius    = pit.isStore ? 2.5f : 1.5f;
+        state.lights.push_back(accent);
+    }
+
+    glm::vec3 boardCenter, boardExtent;
+    if (snapshot.boardIndex >= 0 &&
+        snapshot.objects[snapshot.boardIndex].getWorldBounds(boardCenter, boardExtent)) {
+        constexpr int RIM_LIGHTS_PER_SIDE = 8;
+        for (int side = 0; side < 2; ++side) {
+            float z = boardCenter.z + (side == 0 ? boardExtent.z : -boardExtent.z);
+            for (int i = 0; i < RIM_LIGHTS_PER_SIDE; ++i) {
+                float u = (i + 0.5f) / RIM_LIGHTS_PER_SIDE;
+                AppState::Light rim;
+                rim.position  = glm::vec3(boardCenter.x + (u * 2.0f - 1.0f) * boardExtent.x,
+                                          boardCenter.y + boardExtent.y + 0.2f, z);
+                rim.color     = accentColor(accentIndex++);
+                rim.intensity = 0.4f;
+                rim.radius    = 1.2f;
+                state.lights.push_back(rim);
+            }
+        }
+    }
 }
 
 static void processInput(Window& window, AppState& state) {
-    // Continuous camera pan
+    // Continuous camera pan (the camera comparison in the main loop marks it dirty)
     if (window.isKeyPressed(GLFW_KEY_W)) state.cameraTarget.z -= CAMERA_PAN_SPEED;
     if (window.isKeyPressed(GLFW_KEY_S)) state.cameraTarget.z += CAMERA_PAN_SPEED;
     if (window.isKeyPressed(GLFW_KEY_A)) state.cameraTarget.x -= CAMERA_PAN_SPEED;
@@ -304,12 +793,12 @@ static void processInput(Window& window, AppState& state) {
     if (window.isKeyPressed(GLFW_KEY_E)) state.cameraTarget.y += CAMERA_PAN_SPEED;
 
     // One-press actions (debounced)
-    static bool rWas=false, mWas=false, tWas=false, hWas=false, fWas=false, lWas=false;
+    static bool rWas=false, mWas=false, tWas=false, hWas=false, fWas=false, lWas=false, iWas=false, cWas=false;
+    static bool f12Was=false, f11Was=false, kWas=false, oWas=false, pWas=false;
 
     bool r = window.isKeyPressed(GLFW_KEY_R);
     if (r && !rWas) {
-        state.game->reset();
-        applyThemeToGame(state);
+        state.simulation->submit({ SimulationThread::CommandType::RESET });
         std::cout << "[Game] Reset!\n";
     }
     rWas = r;
@@ -317,32 +806,96 @@ static void processInput(Window& window, AppState& state) {
     bool m = window.isKeyPressed(GLFW_KEY_M);
     if (m && !mWas) {
         state.renderMode.cycleMode();
+        state.redraw.invalidate(RedrawScheduler::HUD);
         std::cout << "[Display] Mode: " << state.renderMode.getModeName() << "\n";
     }
     mWas = m;
 
     bool t = window.isKeyPressed(GLFW_KEY_T);
     if (t && !tWas) {
-        int nextTheme = (state.themeManager.getCurrentThemeIndex() + 1) % state.themeManager.getThemeCount();
-        state.themeManager.setTheme(nextTheme);
-        applyThemeToGame(state);
-        std::cout << "[Theme] Changed to: " << state.themeManager.getCurrentTheme().name << "\n";
+        // Applied by the simulation thread; lights follow when its snapshot arrives
+        int nextTheme = (state.simulation->getSnapshot().themeIndex + 1) % state.themeManager.getThemeCount();
+        state.simulation->submit({ SimulationThread::CommandType::SET_THEME, nextTheme });
+        state.redraw.invalidate(RedrawScheduler::THEME);
+        std::cout << "[Theme] Changed to: " << state.themeManager.getTheme(nextTheme).name << "\n";
     }
     tWas = t;
 
     bool l = window.isKeyPressed(GLFW_KEY_L);
     if (l && !lWas) {
         state.lightsEnabled = !state.lightsEnabled;
+        state.redraw.invalidate(RedrawScheduler::HUD);
         std::cout << "[Lighting] " << (state.lightsEnabled ? "ON" : "OFF") << "\n";
     }
     lWas = l;
 
+    bool k = window.isKeyPressed(GLFW_KEY_K);
+    if (k && !kWas) {
+        state.accentLights = !state.accentLights;
+        setupLights(state);
+        state.redraw.invalidate(RedrawScheduler::HUD);
+        std::cout << "[Lighting] Accent lights " << (state.accentLights ? "ON" : "OFF")
+                  << " (" << state.lights.size() << " lights)\n";
+    }
+    kWas = k;
+
+    bool i = window.isKeyPressed(GLFW_KEY_I);
+    if (i && !iWas && state.indirect) {
+        state.useIndirect = !state.useIndirect;
+        state.redraw.invalidate(RedrawScheduler::HUD);
+        std::cout << "[Render] Multi-draw indirect " << (state.useIndirect ? "ON" : "OFF") << "\n";
+    }
+    iWas = i;
+
+    bool c = window.isKeyPressed(GLFW_KEY_C);
+    if (c && !cWas) {
+        state.frustumCulling = !state.frustumCulling;
+        state.redraw.invalidate(RedrawScheduler::HUD);
+        std::cout << "[Render] Frustum culling " << (state.frustumCulling ? "ON" : "OFF") << "\n";
+    }
+    cWas = c;
+
+    bool o = window.isKeyPressed(GLFW_KEY_O);
+    if (o && !oWas) {
+        state.lodEnabled = !state.lodEnabled;
+        state.redraw.invalidate(RedrawScheduler::HUD);
+        std::cout << "[Render] Mesh LOD " << (state.lodEnabled ? "ON" : "OFF") << "\n";
+    }
+    oWas = o;
+
+    bool f12 = window.isKeyPressed(GLFW_KEY_F12);
+    if (f12 && !f12Was && state.capture) {
+        state.capture->requestScreenshot();
+        state.redraw.invalidate(RedrawScheduler::CAPTURE);
+    }
+    f12Was = f12;
+
+    bool f11 = window.isKeyPressed(GLFW_KEY_F11);
+    if (f11 && !f11Was && state.capture) {
+        if (state.capture->isRecording()) state.capture->stopSequence();
+        else state.capture->startSequence();
+    }
+    f11Was = f11;
+
+    bool p = window.isKeyPressed(GLFW_KEY_P);
+    if (p && !pWas) {
+        state.redraw.setOnDemand(!state.redraw.isOnDemand());
+        std::cout << "[Render] Redraw " << (state.redraw.isOnDemand() ? "on demand" : "continuous") << "\n";
+    }
+    pWas = p;
+
     bool h = window.isKeyPressed(GLFW_KEY_H);
-    if (h && !hWas) state.showHelp = !state.showHelp;
+    if (h && !hWas) {
+        state.showHelp = !state.showHelp;
+        state.redraw.invalidate(RedrawScheduler::HUD);
+    }
     hWas = h;
 
     bool f = window.isKeyPressed(GLFW_KEY_F);
-    if (f && !fWas) state.showStats = !state.showStats;
+    if (f && !fWas) {
+        state.showStats = !state.showStats;
+        state.redraw.invalidate(RedrawScheduler::HUD);
+    }
     fWas = f;
 }
 
@@ -371,66 +924,185 @@ static void handleMousePicking(Window& window, Camera& camera, AppState& state)
         camera
     );
 
-    // pick ONLY pits
-    std::vector<GameObject*> pickables;
-    const auto& pits = state.game->getPits();
-    pickables.reserve(pits.size());
-    for (const auto& p : pits) {
-        if (p.pitObject) pickables.push_back(p.pitObject);
-    }
-
-    ObjectPicker::RayHit hit = ObjectPicker::pickObject(ray, pickables);
-    state.hoveredObject = hit.hit ? hit.object : nullptr;
-
-    // click-to-play
+    // pick ONLY pits: scene BVH query filtered to pit objects
+    const RenderSnapshot& snapshot = state.simulation->getSnapshot();
+    const auto& pits = snapshot.pits;
+    const auto& pickables = snapshot.pickables;   // same indices as sceneObjects
+    SceneBVH::Hit hit = state.sceneBVH.raycast(ray.origin, ray.direction, FLT_MAX,
+                                               [&](int index) { return pickables[index] != EntityStore::NOT_PICKABLE; });
+    int hovered = hit.hit ? pickables[hit.index] : -1;
+    if (hovered != state.hoveredPit) state.redraw.invalidate(RedrawScheduler::HUD);
+    state.hoveredPit = hovered;
+
+    // click-to-play (validated again by the simulation, which owns the game)
     if (leftDown && !leftWasDown) {
-        if (state.hoveredObject && !state.game->isAnimating()) {
-            for (size_t i = 0; i < pits.size(); ++i) {
-                if (pits[i].pitObject == state.hoveredObject) {
-                    int pitIndex = static_cast<int>(i);
-                    if (state.game->isValidMove(pitIndex)) {
-                        state.game->executeMove(pitIndex);
-                    }
-                    break;
-                }
-            }
+        if (state.hoveredPit >= 0 && pits[state.hoveredPit].validMove) {
+            state.simulation->submit({ SimulationThread::CommandType::PLAY_MOVE, state.hoveredPit });
         }
     }
 
     leftWasDown = leftDown;
 }
 
-static void renderScene(Shader& shader, const std::vector<GameObject*>& objects, AppState& state) {
-    auto mode = state.renderMode.getCurrentMode();
+static bool isLightingActive(const AppState& state) {
+    return state.lightsEnabled && !state.lights.empty();
+}
 
-    if (mode == RenderModeManager::Mode::SHADED_WIRE) {
-        // solid pass
-        for (auto* obj : objects) {
-            if (obj && obj->isVisible()) obj->render(shader);
-        }
+static bool isTextured(const GameObject* obj, const AppState& state) {
+    return obj->getTexture() && state.textureMgr.getTextureID(obj->getTexture()) != 0;
+}
+
+static void applyFrameUniforms(Shader& shader, const Camera& camera, AppState& state,
+                               int fbWidth, int fbHeight) {
+    shader.use();
+
+    // matrices
+    shader.setMat4("view", camera.getViewMatrix());
+    shader.setMat4("projection", camera.getProjectionMatrix());
+    shader.setVec3("viewPos", camera.getPosition());
 
-        // wire overlay pass
-        state.renderMode.enableWireframeOverlay();
+    // USE_WIREFRAME variants (SHADED_WIRE)
+    if (state.renderMode.shouldDrawWireframeOverlay()) {
         shader.setVec3("wireframeColor", glm::vec3(0.0f, 0.0f, 0.0f));
-        for (auto* obj : objects) {
-            if (obj && obj->isVisible()) obj->render(shader);
+        shader.setFloat("wireframeWidth", WIREFRAME_LINE_WIDTH);
+    }
+
+    // USE_LIGHTING variants read the light clusters (updated once per frame in renderFrame)
+    if (isLightingActive(state)) {
+        state.lightClusterer->bind(shader, fbWidth, fbHeight);
+    }
+}
+
+static std::vector<GameObject*> cullObjects(const std::vector<GameObject*>& objects, const Camera& camera, AppState& state) {
+    std::vector<GameObject*> visible;
+    visible.reserve(objects.size());
+
+    const Frustum& frustum = camera.getFrustum();
+    glm::vec3 center, extent;
+
+    // Hidden objects (!isVisible) are not frustum tests: they count in neither figure
+    size_t tested = 0;
+    size_t rejected = 0;
+    for (auto* obj : objects) {
+        if (!obj || !obj->isVisible()) continue;
+        ++tested;
+        if (state.frustumCulling && obj->getWorldBounds(center, extent) &&
+            !frustum.intersectsBox(center, extent)) {
+            ++rejected;
+            continue;
         }
-        state.renderMode.disableWireframeOverlay();
-    } else {
-        for (auto* obj : objects) {
-            if (obj && obj->isVisible()) obj->render(shader);
+        visible.push_back(obj);
+    }
+
+    state.totalObjects  = tested;
+    state.culledObjects = rejected;
+    return visible;
+}
+
+static void selectLODs(const std::vector<GameObject*>& objects, const Camera& camera, AppState& state, int fbHeight) {
+    glm::vec3 center, extent;
+
+    for (auto* obj : objects) {
+        if (!obj->getLOD()) continue;
+
+        if (!state.lodEnabled || !obj->getWorldBounds(center, extent)) {
+            obj->updateLOD(-1.0f);
+            continue;
         }
+
+        float size = MeshLOD::projectedSize(glm::length(extent), glm::length(center - camera.getPosition()),
+                                            camera.getFov(), static_cast<float>(fbHeight));
+        obj->updateLOD(size);
+    }
+}
+
+static void drawObjects(const FrameShaders& programs, const std::vector<GameObject*>& objects, AppState& state) {
+    // The MDI arena always holds full-float vertices
+    const bool arena = state.useIndirect && state.indirect;
+
+    for (auto* obj : objects) {
+        if (!obj || !obj->isVisible() || !obj->getMesh()) continue;
+        const Mesh* mesh = obj->getMesh();
+        state.trianglesSubmitted += mesh->getIndices().size() / 3;
+        state.vertexBytesSubmitted += mesh->getVertices().size() * (arena ? sizeof(Vertex) : mesh->getVertexStride());
+        const MeshLOD* lod = obj->getLOD();
+        state.trianglesFullDetail += lod ? lod->getLevel(0).triangleCount
+                                         : obj->getMesh()->getIndices().size() / 3;
+    }
+
+    if (state.useIndirect && state.indirect) {
+        state.indirect->render(objects, *programs.untextured, programs.textured);
+        return;
+    }
+
+    // Material-only objects first, then textured ones: one program switch per pass
+    programs.untextured->use();
+    for (auto* obj : objects) {
+        if (!obj || !obj->isVisible()) continue;
+        if (programs.textured && isTextured(obj, state)) continue;
+        obj->render(*programs.untextured, false);
+    }
+
+    if (!programs.textured) return;
+
+    programs.textured->use();
+    GameObject::resetTextureBinding();
+    for (auto* obj : objects) {
+        if (obj && obj->isVisible() && isTextured(obj, state)) obj->render(*programs.textured, true);
     }
 }
 
+static void renderScene(const FrameShaders& programs, const std::vector<GameObject*>& objects, AppState& state) {
+    // SHADED_WIRE edges are drawn by the USE_WIREFRAME variants in the same pass
+    drawObjects(programs, objects, state);
+}
+
+static bool acquireSnapshot(AppState& state) {
+    SimulationThread& simulation = *state.simulation;
+    if (!simulation.hasNewSnapshot()) return false;
+
+    // LOD levels are picked by the renderer on its copies: carry them over so the
+    // hysteresis survives the switch to the new copies
+    std::unordered_map<uint64_t, int> lodLevels;
+    const RenderSnapshot& previous = simulation.getSnapshot();
+    for (size_t i = 0; i < previous.objects.size(); ++i) {
+        if (previous.objects[i].getLOD()) lodLevels[previous.handles[i].getKey()] = previous.objects[i].getLODLevel();
+    }
+
+    simulation.acquireSnapshot();
+    RenderSnapshot& snapshot = simulation.getSnapshot();
+
+    state.sceneObjects.clear();
+    for (size_t i = 0; i < snapshot.objects.size(); ++i) {
+        auto level = lodLevels.find(snapshot.handles[i].getKey());
+        if (level != lodLevels.end()) snapshot.objects[i].setLODLevel(level->second);
+        state.sceneObjects.push_back(&snapshot.objects[i]);
+    }
+
+    // Model matrices arrive cached in the copies (batch-updated by the simulation):
+    // neither the BVH nor the draws recompute them
+    // Only objects whose transform changed since the last snapshot are refit
+    state.sceneBVH.update(state.sceneObjects);
+
+    // Whole scene, before culling: objects coming back into view or switching LOD
+    // never hit a mesh the MDI arena doesn't hold yet
+    if (state.indirect) state.indirect->registerObjects(state.sceneObjects);
+
+    if (snapshot.themeIndex != state.lightsThemeIndex) {
+        setupLights(state);
+    }
+    return true;
+}
+
 static void drawImGuiHUD(AppState& state) {
     // Score window
     ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_Always);
     ImGui::Begin("Score", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
 
-    int p1 = state.game->getStoreCount(MancalaGame::Player::PLAYER_ONE);
-    int p2 = state.game->getStoreCount(MancalaGame::Player::PLAYER_TWO);
-    auto cp = state.game->getCurrentPlayer();
+    const RenderSnapshot& snapshot = state.simulation->getSnapshot();
+    int p1 = snapshot.storeCounts[0];
+    int p2 = snapshot.storeCounts[1];
+    auto cp = snapshot.currentPlayer;
 
     ImGui::Text("Current: %s",
         (cp == MancalaGame::Player::PLAYER_ONE) ? "Player 1 (Bottom)" : "Player 2 (Top)");
@@ -441,9 +1113,9 @@ static void drawImGuiHUD(AppState& state) {
     ImGui::Separator();
     ImGui::Text("Lighting: %s", state.lightsEnabled ? "ON" : "OFF");
 
-    if (state.game->isGameOver()) {
+    if (snapshot.isGameOver()) {
         ImGui::Separator();
-        auto gs = state.game->getGameState();
+        auto gs = snapshot.gameState;
         if (gs == MancalaGame::GameState::PLAYER_ONE_WON) ImGui::Text("Winner: Player 1");
         else if (gs == MancalaGame::GameState::PLAYER_TWO_WON) ImGui::Text("Winner: Player 2");
         else ImGui::Text("Result: Draw");
@@ -464,8 +1136,15 @@ static void drawImGuiHUD(AppState& state) {
         ImGui::Text("T        : Theme");
         ImGui::Text("M        : Render mode");
         ImGui::Text("L        : Toggle lighting");
+        ImGui::Text("K        : Toggle accent lights");
+        ImGui::Text("I        : Toggle multi-draw indirect");
+        ImGui::Text("C        : Toggle frustum culling");
+        ImGui::Text("O        : Toggle mesh LOD");
+        ImGui::Text("P        : Toggle render on demand");
         ImGui::Text("H        : Toggle help");
         ImGui::Text("F        : Toggle stats");
+        ImGui::Text("F12      : Screenshot");
+        ImGui::Text("F11      : Record image sequence");
         ImGui::End();
     }
 
@@ -474,6 +1153,92 @@ static void drawImGuiHUD(AppState& state) {
         ImGui::SetNextWindowPos(ImVec2(10, 330), ImGuiCond_Always);
         ImGui::Begin("Stats", &state.showStats, ImGuiWindowFlags_AlwaysAutoResize);
         ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
+        ImGui::Text("Simulation: tick %llu, last step %.3f ms%s",
+                    static_cast<unsigned long long>(snapshot.tick), snapshot.stepMs,
+                    snapshot.animating ? " (animating)" : "");
+        if (state.redraw.isOnDemand()) {
+            ImGui::Text("Redraw: on demand (%llu drawn, %llu idle wakeups) - %s",
+                        static_cast<unsigned long long>(state.redraw.getFramesRendered()),
+                        static_cast<unsigned long long>(state.redraw.getFramesSkipped()),
+                        RedrawScheduler::describe(state.redraw.getLastReasons()).c_str());
+        }
+        if (state.useIndirect && state.indirect) {
+            ImGui::Text("Submit: MDI (%zu draws, %zu meshes, %zu batches)",
+                        state.indirect->getDrawCount(), state.indirect->getMeshCount(),
+                        state.indirect->getBatchCount());
+        } else {
+            ImGui::Text("Submit: per-object");
+        }
+        ImGui::Text("Picking BVH: %zu objects, %zu nodes | %llu rebuilds, %llu refits (last %zu objects)",
+                    state.sceneBVH.getObjectCount(), state.sceneBVH.getNodeCount(),
+                    static_cast<unsigned long long>(state.sceneBVH.getRebuildCount()),
+                    static_cast<unsigned long long>(state.sceneBVH.getRefitCount()),
+                    state.sceneBVH.getLastRefitObjects());
+        ImGui::Text("Transforms: %zu (last batch %zu)", state.sceneObjects.size(),
+                    state.simulation->getSnapshot().transformBatch);
+        ImGui::Text("Culled: %zu / %zu%s", state.culledObjects, state.totalObjects,
+                    state.frustumCulling ? "" : " (off)");
+        ImGui::Text("Triangles: %zu (LOD 0: %zu)%s", state.trianglesSubmitted, state.trianglesFullDetail,
+                    state.lodEnabled ? "" : " (LOD off)");
+        ImGui::Text("Vertex data: %.1f KB/frame (%s)", state.vertexBytesSubmitted / 1024.0f,
+                    Mesh::getDefaultVertexFormat() == VertexFormat::PACKED ? "packed" : "float");
+        if (state.textureMgr.getPendingCount() > 0) {
+            ImGui::Text("Textures loading: %zu", state.textureMgr.getPendingCount());
+        }
+        if (state.lightClusterer) {
+            const LightClusterer& lc = *state.lightClusterer;
+            ImGui::Text("Lights: %zu | clusters %d / %d | max %d per cluster",
+                        lc.getLightCount(), lc.getActiveClusterCount(),
+                        LightClusterer::CLUSTER_COUNT, lc.getMaxLightsPerCluster());
+        }
+        if (state.capture) {
+            ImGui::Text("Capture: %s | written %zu | pending %zu | dropped %zu",
+                        state.capture->isRecording() ? "REC" : "idle",
+                        state.capture->getFramesWritten(), state.capture->getPendingWrites(),
+                        state.capture->getFramesDropped());
+        }
+
+        if (state.profiler) {
+            const FrameProfiler& prof = *state.profiler;
+            const FrameProfiler::Stats& frame = prof.getFrameStats();
+
+            ImGui::Separator();
+            ImGui::Text("Frame: %.2f ms avg | p95 %.2f | p99 %.2f", frame.avg, frame.p95, frame.p99);
+
+            int offset = 0;
+            const float* history = prof.getFrameHistory(offset);
+            ImGui::PlotLines("##frametime", history, FrameProfiler::HISTORY_SIZE, offset,
+                             "frame ms", 0.0f, std::max(33.3f, frame.max), ImVec2(260, 60));
+
+            if (ImGui::BeginTable("phases", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Phase");
+                ImGui::TableSetupColumn("CPU avg");
+                ImGui::TableSetupColumn("CPU p95");
+                ImGui::TableSetupColumn("CPU p99");
+                ImGui::TableSetupColumn("GPU avg");
+                ImGui::TableHeadersRow();
+
+                for (int i = 0; i < FrameProfiler::PHASE_COUNT; ++i) {
+                    auto phase = static_cast<FrameProfiler::Phase>(i);
+                    const FrameProfiler::Stats& cpu = prof.getCpuStats(phase);
+                    const FrameProfiler::Stats& gpu = prof.getGpuStats(phase);
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::Text("%s", FrameProfiler::getPhaseName(phase));
+                    ImGui::TableNextColumn(); ImGui::Text("%.2f", cpu.avg);
+                    ImGui::TableNextColumn(); ImGui::Text("%.2f", cpu.p95);
+                    ImGui::TableNextColumn(); ImGui::Text("%.2f", cpu.p99);
+                    ImGui::TableNextColumn(); ImGui::Text("%.2f", gpu.avg);
+                }
+                ImGui::EndTable();
+            }
+
+            // Swap waits on vsync/GPU: per-frame totals without it, on both sides
+            float cpuWork = prof.getCpuWorkStats().avg;
+            float gpuWork = prof.getGpuWorkStats().avg;
+            ImGui::Text("CPU work %.2f ms | GPU %.2f ms -> %s", cpuWork, gpuWork,
+                        cpuWork > gpuWork ? "CPU-bound" : "GPU-bound");
+        }
         ImGui::End();
     }
 }